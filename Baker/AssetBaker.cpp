@@ -0,0 +1,234 @@
+#include <iostream>
+
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QSurfaceFormat>
+#include <QThreadPool>
+
+#include "AssetBaker.h"
+#include "Exception.h"
+#include "Import/ModelImporter.h"
+#include "Import/ModelBinaryCache.h"
+#include "Import/ModelCache.h"
+#include "Import/CompressedTextureCache.h"
+#include "Import/CubeTextureCache.h"
+#include "Scene/SceneManifest.h"
+
+#include "Core/Engine.h"
+
+namespace {
+    std::string getAbsolutePath(const std::string& path) {
+        return QFileInfo(QString::fromStdString(path)).absoluteFilePath().toStdString();
+    }
+}
+
+AssetBaker::AssetBaker(const Options& options): options(options) {
+
+}
+
+Core::UInt32 AssetBaker::bakeDirectory(const std::string& directory) {
+    QElapsedTimer timer;
+    timer.start();
+
+    // scene assets keep the paths the scenes use, since that's what their cache keys see; only the
+    // ones that resolve to a file under the directory are baked
+    QString root = QDir(QString::fromStdString(directory)).absolutePath() + "/";
+    auto isUnderRoot = [&root](const std::string& path) {
+        QFileInfo info(QString::fromStdString(path));
+        return info.exists() && info.absoluteFilePath().startsWith(root);
+    };
+
+    std::vector<ImportSettings> models;
+    std::unordered_set<std::string> sceneFiles;
+    for (const ImportSettings& settings : this->getSceneImports()) {
+        if (!isUnderRoot(settings.path)) continue;
+        models.push_back(settings);
+        sceneFiles.insert(getAbsolutePath(settings.path));
+    }
+    Core::UInt32 sceneModelCount = models.size();
+    std::vector<SceneAssets::Sky> skies;
+    for (const SceneAssets::Sky& sky : SceneAssets::getSkies()) {
+        if (!isUnderRoot(sky.path)) continue;
+        skies.push_back(sky);
+        sceneFiles.insert(getAbsolutePath(sky.path));
+    }
+
+    // everything else keeps the path the iterator builds from the directory argument
+    std::vector<std::string> textures;
+    QDirIterator itr(QString::fromStdString(directory), QDir::Files, QDirIterator::Subdirectories);
+    while (itr.hasNext()) {
+        std::string path = itr.next().toStdString();
+        if (sceneFiles.count(getAbsolutePath(path)) > 0) continue;
+        if (isModelFile(path)) models.push_back(this->getImportSettings(path));
+        else if (isTextureFile(path)) textures.push_back(path);
+    }
+    std::cout << "AssetBaker::bakeDirectory() -> Found " << models.size() << " model imports (" << sceneModelCount << " from scenes), "
+              << textures.size() << " textures and " << skies.size() << " skies under '" << directory << "'" << std::endl;
+
+    // models queue the textures they reference as they finish, so everything drains through the one pool
+    QThreadPool* pool = QThreadPool::globalInstance();
+    for (const ImportSettings& settings : models) {
+        pool->start([this, settings]() {
+            this->bakeModel(settings);
+        });
+    }
+    for (const std::string& path : textures) {
+        this->queueTexture(path, false);
+    }
+    pool->waitForDone();
+
+    if (this->options.bakeSkies && skies.size() > 0) this->bakeSkies(skies);
+
+    QMutexLocker ml(&this->stateMutex);
+    std::cout << "AssetBaker::bakeDirectory() -> Baked " << this->modelsBaked << " models (" << this->modelsCurrent << " already current), "
+              << this->texturesBaked << " textures and " << this->skiesBaked << " skies on " << pool->maxThreadCount() << " threads in "
+              << timer.elapsed() << " ms, " << this->failures << " failed" << std::endl;
+    return this->failures;
+}
+
+void AssetBaker::bakeModel(const ImportSettings& settings) {
+    const std::string& path = settings.path;
+    std::shared_ptr<ModelDescription> description = ModelBinaryCache::read(settings);
+    Core::Bool current = description != nullptr;
+    if (!current) {
+        try {
+            description = ModelImporter::importModel(settings);
+        }
+        catch (const Exception& ex) {
+            this->reportFailure(path, ex.msg);
+            return;
+        }
+        if (!ModelBinaryCache::write(*description)) {
+            this->reportFailure(path, "unable to write model cache");
+            return;
+        }
+    }
+
+    // normal maps get their own uncompressed entry, as ModelBuilder requests them
+    std::vector<Core::Bool> isNormalMap(description->images.size(), false);
+    for (const MaterialDescription& material : description->materials) {
+        if (material.normalImage >= 0) isNormalMap[material.normalImage] = true;
+    }
+    for (Core::UInt32 i = 0; i < description->images.size(); i++) {
+        this->queueTexture(description->images[i].path, isNormalMap[i]);
+    }
+
+    QMutexLocker ml(&this->stateMutex);
+    if (current) this->modelsCurrent++;
+    else this->modelsBaked++;
+}
+
+void AssetBaker::queueTexture(const std::string& path, Core::Bool isNormalMap) {
+    // models share textures, and a texture may also be picked up by the directory scan
+    std::string key = QFileInfo(QString::fromStdString(path)).absoluteFilePath().toStdString() + (isNormalMap ? "|normal" : "");
+    {
+        QMutexLocker ml(&this->stateMutex);
+        if (!this->queuedTextures.insert(key).second) return;
+    }
+    QThreadPool::globalInstance()->start([this, path, isNormalMap]() {
+        this->bakeTexture(path, isNormalMap);
+    });
+}
+
+void AssetBaker::bakeTexture(const std::string& path, Core::Bool isNormalMap) {
+    // load() reuses a current cache entry, otherwise decodes, compresses and writes one
+    if (!CompressedTextureCache::load(path, isNormalMap)) {
+        this->reportFailure(path, "unable to decode image");
+        return;
+    }
+    QMutexLocker ml(&this->stateMutex);
+    this->texturesBaked++;
+}
+
+void AssetBaker::bakeSkies(const std::vector<SceneAssets::Sky>& skies) {
+    // the equirectangular conversion renders, so it needs a context, but not a window
+    QSurfaceFormat format;
+    format.setVersion(3, 3);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+    QOffscreenSurface surface;
+    surface.setFormat(format);
+    surface.create();
+    QOpenGLContext context;
+    context.setFormat(format);
+    if (!context.create() || !context.makeCurrent(&surface)) {
+        for (const SceneAssets::Sky& sky : skies) {
+            this->reportFailure(sky.path, "unable to create an OpenGL 3.3 context");
+        }
+        return;
+    }
+
+    Core::WeakPointer<Core::Engine> engine = Core::Engine::instance();
+    for (const SceneAssets::Sky& sky : skies) {
+        Core::WeakPointer<Core::CubeTexture> skyTexture = CubeTextureCache::loadFromEquirectangularImage(engine, sky.path, sky.isHDR, sky.rotation);
+        if (!skyTexture.isValid()) {
+            this->reportFailure(sky.path, "unable to convert sky");
+            continue;
+        }
+        Core::Engine::safeReleaseObject(skyTexture);
+        QMutexLocker ml(&this->stateMutex);
+        this->skiesBaked++;
+    }
+    context.doneCurrent();
+}
+
+std::vector<ImportSettings> AssetBaker::getSceneImports() {
+    std::vector<ImportSettings> imports;
+    imports.push_back(SceneAssets::getTerrainImport(true));
+    imports.push_back(SceneAssets::getWarriorImport(true));
+    for (const std::string& manifestPath : SceneAssets::getManifests()) {
+        SceneManifest manifest;
+        if (!manifest.load(manifestPath)) {
+            this->reportFailure(manifestPath, "unable to load scene manifest");
+            continue;
+        }
+        // tags only leave instances out of some scenes, so every instance is baked
+        for (const SceneManifest::ModelInstance& instance : manifest.getModels()) {
+            imports.push_back(SceneAssets::getStandardImport(instance.path, instance.usePhysicalMaterial, instance.castShadows, instance.transparent));
+        }
+        for (const std::string& path : manifest.getPrefetchPaths()) {
+            imports.push_back(SceneAssets::getStandardImport(path, true, true, false));
+        }
+    }
+
+    // instances repeat models; ModelCache::getKey() is what makes two imports the same cache entry
+    std::vector<ImportSettings> uniqueImports;
+    std::unordered_set<std::string> keys;
+    for (ImportSettings& settings : imports) {
+        // Core's loader builds non-physical models itself, nothing of theirs is cached
+        if (!settings.usePhysicalMaterial) continue;
+        settings.optimizeMeshes = this->options.optimizeMeshes;
+        if (keys.insert(ModelCache::getKey(settings)).second) uniqueImports.push_back(settings);
+    }
+    return uniqueImports;
+}
+
+ImportSettings AssetBaker::getImportSettings(const std::string& path) const {
+    ImportSettings settings;
+    settings.path = path;
+    settings.scale = this->options.scale;
+    settings.smoothingThreshold = this->options.smoothingThreshold;
+    settings.preserveFBXPivots = this->options.preserveFBXPivots;
+    settings.usePhysicalMaterial = true;
+    settings.optimizeMeshes = this->options.optimizeMeshes;
+    return settings;
+}
+
+void AssetBaker::reportFailure(const std::string& path, const std::string& reason) {
+    QMutexLocker ml(&this->stateMutex);
+    this->failures++;
+    std::cout << "AssetBaker -> Failed to bake '" << path << "': " << reason << std::endl;
+}
+
+Core::Bool AssetBaker::isModelFile(const std::string& path) {
+    QString suffix = QFileInfo(QString::fromStdString(path)).suffix().toLower();
+    return suffix == "fbx" || suffix == "obj" || suffix == "dae" || suffix == "gltf" || suffix == "glb" || suffix == "3ds";
+}
+
+Core::Bool AssetBaker::isTextureFile(const std::string& path) {
+    QString suffix = QFileInfo(QString::fromStdString(path)).suffix().toLower();
+    return suffix == "png" || suffix == "jpg" || suffix == "jpeg" || suffix == "tga" || suffix == "bmp";
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <QMutex>
+
+#include "Core/common/types.h"
+#include "Core/math/Math.h"
+
+#include "Import/ModelDescription.h"
+#include "Scene/SceneAssets.h"
+
+// Fills the on-disk caches the modeler reads at startup (ModelBinaryCache,
+// CompressedTextureCache and CubeTextureCache) for every asset under a directory, so
+// nobody pays for a first import interactively. Models and textures are baked on all
+// cores; skies need the GL context and are converted one at a time afterwards.
+//
+// Cache keys include the path as given and the import/conversion settings. Models the
+// scenes load (SceneAssets and the scene manifests) and the scenes' skies are baked with
+// exactly those settings and paths, so run it from the directory the modeler runs from.
+// Any other model under the directory is baked with Options.
+class AssetBaker {
+public:
+    class Options {
+    public:
+        // for models no scene loads; defaults match SceneHelper::loadModelStandard()
+        Core::Real scale = 1.0f;
+        Core::Real smoothingThreshold = 85.0f * Core::Math::DegreesToRads;
+        Core::Bool preserveFBXPivots = true;
+        // applies to every model, scene ones included
+        Core::Bool optimizeMeshes = true;
+        Core::Bool bakeSkies = true;
+    };
+
+    AssetBaker(const Options& options);
+
+    // Returns the number of assets that failed to bake.
+    Core::UInt32 bakeDirectory(const std::string& directory);
+
+    static Core::Bool isModelFile(const std::string& path);
+    static Core::Bool isTextureFile(const std::string& path);
+
+private:
+    void bakeModel(const ImportSettings& settings);
+    void queueTexture(const std::string& path, Core::Bool isNormalMap);
+    void bakeTexture(const std::string& path, Core::Bool isNormalMap);
+    void bakeSkies(const std::vector<SceneAssets::Sky>& skies);
+    std::vector<ImportSettings> getSceneImports();
+    ImportSettings getImportSettings(const std::string& path) const;
+    void reportFailure(const std::string& path, const std::string& reason);
+
+    Options options;
+
+    QMutex stateMutex;
+    std::unordered_set<std::string> queuedTextures;
+    Core::UInt32 modelsBaked = 0;
+    Core::UInt32 modelsCurrent = 0;
+    Core::UInt32 texturesBaked = 0;
+    Core::UInt32 skiesBaked = 0;
+    Core::UInt32 failures = 0;
+};
@@ -0,0 +1,99 @@
+#include <iostream>
+
+#include <QElapsedTimer>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QSurfaceFormat>
+#include <QThreadPool>
+
+#include "NormalBenchmark.h"
+#include "Exception.h"
+#include "Import/ModelImporter.h"
+#include "Import/NormalGenerator.h"
+
+#include "Core/material/StandardAttributes.h"
+
+Core::UInt32 NormalBenchmark::run(const std::vector<std::string>& paths, Core::Real smoothingThreshold, Core::UInt32 iterations) {
+    QSurfaceFormat format;
+    format.setVersion(3, 3);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+    QOffscreenSurface surface;
+    surface.setFormat(format);
+    surface.create();
+    QOpenGLContext context;
+    context.setFormat(format);
+    if (!context.create() || !context.makeCurrent(&surface)) {
+        std::cout << "NormalBenchmark::run() -> Unable to create an OpenGL 3.3 context for Core's meshes" << std::endl;
+        return paths.size();
+    }
+    Core::WeakPointer<Core::Engine> engine = Core::Engine::instance();
+
+    std::cout << "NormalBenchmark::run() -> " << paths.size() << " models, " << iterations << " iterations, "
+              << QThreadPool::globalInstance()->maxThreadCount() << " threads" << std::endl;
+
+    Core::UInt32 failures = 0;
+    Core::Int64 totalCoreNs = 0;
+    Core::Int64 totalGeneratorNs = 0;
+    for (const std::string& path : paths) {
+        ImportSettings settings;
+        settings.path = path;
+        settings.smoothingThreshold = smoothingThreshold;
+        std::shared_ptr<ModelDescription> description;
+        try {
+            description = ModelImporter::importModel(settings);
+        }
+        catch (const Exception& ex) {
+            std::cout << "NormalBenchmark -> Failed to import '" << path << "': " << ex.msg << std::endl;
+            failures++;
+            continue;
+        }
+        // skinned models come back without meshes, Core's loader smooths those itself
+        if (description->meshes.size() == 0) continue;
+
+        Core::UInt64 vertexCount = 0;
+        Core::Int64 coreNs = 0;
+        Core::Int64 generatorNs = 0;
+        for (const MeshDescription& source : description->meshes) {
+            vertexCount += source.vertexCount;
+            for (Core::UInt32 i = 0; i < iterations; i++) {
+                Core::WeakPointer<Core::Mesh> coreMesh = buildCoreMesh(engine, source);
+                QElapsedTimer timer;
+                timer.start();
+                coreMesh->calculateNormals(smoothingThreshold);
+                coreNs += timer.nsecsElapsed();
+                Core::Engine::safeReleaseObject(coreMesh);
+
+                MeshDescription generated = source;
+                timer.restart();
+                NormalGenerator::computeNormals(generated, smoothingThreshold);
+                generatorNs += timer.nsecsElapsed();
+            }
+        }
+
+        totalCoreNs += coreNs;
+        totalGeneratorNs += generatorNs;
+        std::cout << "NormalBenchmark -> '" << path << "': " << description->meshes.size() << " meshes, " << vertexCount << " vertices, Core "
+                  << (coreNs / iterations) / 1000000.0 << " ms, NormalGenerator " << (generatorNs / iterations) / 1000000.0 << " ms ("
+                  << (generatorNs > 0 ? (Core::Real)coreNs / generatorNs : 0.0f) << "x)" << std::endl;
+    }
+    context.doneCurrent();
+
+    std::cout << "NormalBenchmark::run() -> Total Core " << (totalCoreNs / iterations) / 1000000.0 << " ms, NormalGenerator "
+              << (totalGeneratorNs / iterations) / 1000000.0 << " ms (" << (totalGeneratorNs > 0 ? (Core::Real)totalCoreNs / totalGeneratorNs : 0.0f)
+              << "x), " << failures << " failed" << std::endl;
+    return failures;
+}
+
+Core::WeakPointer<Core::Mesh> NormalBenchmark::buildCoreMesh(Core::WeakPointer<Core::Engine> engine, const MeshDescription& source) {
+    Core::WeakPointer<Core::Mesh> mesh = engine->createMesh(source.vertexCount, source.indices.size());
+    mesh->init();
+    mesh->enableAttribute(Core::StandardAttribute::Position);
+    mesh->initVertexPositions();
+    mesh->getVertexPositions()->store(source.positions.data());
+    mesh->enableAttribute(Core::StandardAttribute::Normal);
+    mesh->initVertexNormals();
+    mesh->enableAttribute(Core::StandardAttribute::FaceNormal);
+    mesh->initVertexFaceNormals();
+    mesh->getIndexBuffer()->setIndices(source.indices.data());
+    return mesh;
+}
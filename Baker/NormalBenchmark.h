@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Core/common/types.h"
+#include "Core/Engine.h"
+#include "Core/geometry/Mesh.h"
+
+#include "Import/ModelDescription.h"
+
+// Times NormalGenerator against what smoothing cost before it: Core::Mesh::calculateNormals()
+// on the same geometry, which is what ModelBuilder still falls back to for meshes without
+// imported normals. Core's meshes live in GL buffers, so this needs a context, like the skies.
+class NormalBenchmark {
+public:
+    // Returns the number of models that failed to import.
+    static Core::UInt32 run(const std::vector<std::string>& paths, Core::Real smoothingThreshold, Core::UInt32 iterations);
+
+private:
+    // positions and indices only, so calculateNormals() has everything to do
+    static Core::WeakPointer<Core::Mesh> buildCoreMesh(Core::WeakPointer<Core::Engine> engine, const MeshDescription& source);
+};
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <iostream>
+
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QDirIterator>
+
+#include "AssetBaker.h"
+#include "NormalBenchmark.h"
+#include "Import/ImportWorkerPool.h"
+#include "Import/MeshOptimizer.h"
+
+int main(int argc, char *argv[])
+{
+    // sky conversion needs a GL context but never a window, so don't require a display
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+
+    // must match the modeler so baked files land in the cache directory it reads from
+    QCoreApplication::setApplicationName("Modeler");
+    QCoreApplication::setOrganizationName("GhostTree");
+    QCoreApplication::setApplicationVersion(QT_VERSION_STR);
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Bakes models, textures and scene skies under a directory into the Modeler asset caches. Models and skies the "
+                                     "scenes load are baked with the scenes' settings; the import options apply to every other model.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("directory", "Asset directory, given relative to the Modeler's working directory (e.g. 'assets').");
+    QCommandLineOption scaleOption("scale", "Import scale for models no scene loads.", "scale", "1.0");
+    parser.addOption(scaleOption);
+    QCommandLineOption smoothingOption("smoothing-threshold", "Normal smoothing threshold in degrees for models no scene loads.", "degrees", "85");
+    parser.addOption(smoothingOption);
+    QCommandLineOption noPivotsOption("no-fbx-pivots", "Don't preserve FBX pivots in models no scene loads.");
+    parser.addOption(noPivotsOption);
+    QCommandLineOption noOptimizeOption("no-optimize-meshes", "Don't reorder meshes for vertex cache, overdraw and fetch locality.");
+    parser.addOption(noOptimizeOption);
+    QCommandLineOption measureOverdrawOption(QString(ImportWorkerPool::MeasureOverdrawArgument).mid(2), "Log each optimized model's overdraw before "
+                                             "and after (rasterizes every mesh twice from six directions, so baking takes noticeably longer).");
+    parser.addOption(measureOverdrawOption);
+    QCommandLineOption noSkiesOption("no-skies", "Skip the scenes' skies (no OpenGL context is created).");
+    parser.addOption(noSkiesOption);
+    QCommandLineOption benchmarkNormalsOption("benchmark-normals", "Instead of baking, time Core's normal smoothing against the importer's on every "
+                                              "model under the directory.", "iterations");
+    parser.addOption(benchmarkNormalsOption);
+    QCommandLineOption importWorkerOption(QString(ImportWorkerPool::WorkerArgument).mid(2), "Serve model imports for the Modeler over stdin/stdout "
+                                          "instead of baking.");
+    parser.addOption(importWorkerOption);
+    parser.process(app);
+
+    MeshOptimizer::setOverdrawMeasured(parser.isSet(measureOverdrawOption));
+
+    if (parser.isSet(importWorkerOption)) {
+        return ImportWorkerPool::serve();
+    }
+
+    const QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 1) {
+        parser.showHelp(1);
+    }
+
+    if (parser.isSet(benchmarkNormalsOption)) {
+        std::vector<std::string> models;
+        QDirIterator itr(arguments.at(0), QDir::Files, QDirIterator::Subdirectories);
+        while (itr.hasNext()) {
+            std::string path = itr.next().toStdString();
+            if (AssetBaker::isModelFile(path)) models.push_back(path);
+        }
+        Core::UInt32 iterations = std::max(parser.value(benchmarkNormalsOption).toUInt(), 1u);
+        Core::Real smoothingThreshold = parser.value(smoothingOption).toFloat() * Core::Math::DegreesToRads;
+        return NormalBenchmark::run(models, smoothingThreshold, iterations) > 0 ? 1 : 0;
+    }
+
+    AssetBaker::Options options;
+    options.scale = parser.value(scaleOption).toFloat();
+    options.smoothingThreshold = parser.value(smoothingOption).toFloat() * Core::Math::DegreesToRads;
+    options.preserveFBXPivots = !parser.isSet(noPivotsOption);
+    options.optimizeMeshes = !parser.isSet(noOptimizeOption);
+    options.bakeSkies = !parser.isSet(noSkiesOption);
+
+    AssetBaker baker(options);
+    Core::UInt32 failures = baker.bakeDirectory(arguments.at(0).toStdString());
+    return failures > 0 ? 1 : 0;
+}
@@ -1,6 +1,8 @@
 #include "CoreScene.h"
 
 #include "Core/render/Camera.h"
+#include "Core/math/Math.h"
+#include "Core/math/Matrix4x4.h"
 
 CoreScene::CoreScene() {
 
@@ -29,6 +31,32 @@ void CoreScene::addObjectToScene(Core::WeakPointer<Core::Object3D> object, Core:
     }
 }
 
+void CoreScene::clearScene(const std::vector<Core::WeakPointer<Core::Object3D>>& persistentObjects) {
+    this->clearSelectedObjects();
+    this->sceneRaycaster = Core::RayCaster();
+    this->meshToObjectsMap.clear();
+
+    std::vector<Core::WeakPointer<Core::Object3D>> sceneObjects;
+    for (Core::UInt32 i = 0; i < this->sceneRoot->childCount(); i++) {
+        Core::WeakPointer<Core::Object3D> child = this->sceneRoot->getChild(i);
+        bool persistent = false;
+        for (const Core::WeakPointer<Core::Object3D>& persistentObject : persistentObjects) {
+            if (persistentObject.get() == child.get()) persistent = true;
+        }
+        if (!persistent) sceneObjects.push_back(child);
+    }
+
+    // releasing a root takes its whole subtree with it, lights, probes and particle systems included;
+    // meshes, materials and textures belong to the caches and are left alone
+    for (Core::WeakPointer<Core::Object3D> object : sceneObjects) {
+        this->sceneRoot->removeChild(object);
+        Core::Engine::safeReleaseObject(object);
+    }
+    for (auto& callback : this->sceneUpdatedCallbacks) {
+        callback(this->sceneRoot);
+    }
+}
+
 void CoreScene::onSceneUpdated(SceneUpdatedCallback callback) {
     this->sceneUpdatedCallbacks.push_back(callback);
 }
@@ -98,8 +126,7 @@ void CoreScene::rayCastForObjectSelection(Core::WeakPointer<Core::Camera> camera
 
     if (hitOccurred) {
         Core::Hit& hit = hits[0];
-        Core::WeakPointer<Core::Mesh> hitObject = hit.Object;
-        Core::WeakPointer<Core::Object3D> rootObject =this->meshToObjectMap[hitObject->getObjectID()];
+        Core::WeakPointer<Core::Object3D> rootObject = this->resolveHitObject(hit);
 
         if (setSelectedObject) {
             if (multiSelect) {
@@ -115,5 +142,33 @@ void CoreScene::rayCastForObjectSelection(Core::WeakPointer<Core::Camera> camera
 
 void CoreScene::addObjectToSceneRaycaster(Core::WeakPointer<Core::Object3D> object, Core::WeakPointer<Core::Mesh> mesh) {
     this->sceneRaycaster.addObject(object, mesh);
-    this->meshToObjectMap[mesh->getObjectID()] = object;
+    this->meshToObjectsMap[mesh->getObjectID()].push_back(object);
+}
+
+Core::WeakPointer<Core::Object3D> CoreScene::resolveHitObject(const Core::Hit& hit) {
+    Core::WeakPointer<Core::Mesh> hitObject = hit.Object;
+    std::vector<Core::WeakPointer<Core::Object3D>>& candidates = this->meshToObjectsMap[hitObject->getObjectID()];
+    if (candidates.size() == 0) return Core::WeakPointer<Core::Object3D>();
+    if (candidates.size() == 1) return candidates[0];
+
+    // pick the instance whose local-space bounding box is closest to the hit point
+    const Core::Box3& bounds = hitObject->getBoundingBox();
+    Core::WeakPointer<Core::Object3D> closest = candidates[0];
+    Core::Real closestDistance = -1.0f;
+    for (Core::WeakPointer<Core::Object3D> candidate : candidates) {
+        Core::Matrix4x4 inverseWorld = candidate->getTransform().getWorldMatrix();
+        inverseWorld.invert();
+        Core::Point3r localHit = hit.Origin;
+        inverseWorld.transform(localHit);
+
+        Core::Real dx = Core::Math::max(Core::Math::max(bounds.getMin().x - localHit.x, localHit.x - bounds.getMax().x), 0.0f);
+        Core::Real dy = Core::Math::max(Core::Math::max(bounds.getMin().y - localHit.y, localHit.y - bounds.getMax().y), 0.0f);
+        Core::Real dz = Core::Math::max(Core::Math::max(bounds.getMin().z - localHit.z, localHit.z - bounds.getMax().z), 0.0f);
+        Core::Real distance = dx * dx + dy * dy + dz * dz;
+        if (closestDistance < 0.0f || distance < closestDistance) {
+            closestDistance = distance;
+            closest = candidate;
+        }
+    }
+    return closest;
 }
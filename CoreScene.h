@@ -20,6 +20,8 @@ public:
     void setSceneRoot(Core::WeakPointer<Core::Object3D> sceneRoot);
     void addObjectToScene(Core::WeakPointer<Core::Object3D> object);
     void addObjectToScene(Core::WeakPointer<Core::Object3D> object, Core::WeakPointer<Core::Object3D> parent);
+    // Releases every child of the scene root except the given ones, and forgets the selection and raycaster entries.
+    void clearScene(const std::vector<Core::WeakPointer<Core::Object3D>>& persistentObjects);
     void onSceneUpdated(SceneUpdatedCallback callback);
     std::vector<Core::WeakPointer<Core::Object3D>>& getSelectedObjects();
     void addSelectedObject(Core::WeakPointer<Core::Object3D> newSelectedObject);
@@ -33,10 +35,12 @@ public:
 
 private:
     void removeSelectedObjectAtIndex(unsigned int index);
+    Core::WeakPointer<Core::Object3D> resolveHitObject(const Core::Hit& hit);
 
     Core::WeakPointer<Core::Engine> engine;
     Core::RayCaster sceneRaycaster;
-    std::unordered_map<Core::UInt64, Core::WeakPointer<Core::Object3D>> meshToObjectMap;
+    // cached models share meshes between instances, so one mesh can map to several objects
+    std::unordered_map<Core::UInt64, std::vector<Core::WeakPointer<Core::Object3D>>> meshToObjectsMap;
     Core::WeakPointer<Core::Object3D> sceneRoot;
     std::vector<SceneUpdatedCallback> sceneUpdatedCallbacks;
     std::vector<Core::WeakPointer<Core::Object3D>> selectedObjects;
@@ -1,16 +1,334 @@
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <sstream>
+
 #include "Core/Engine.h"
 
 #include "CoreSync.h"
+#include "Exception.h"
+
+const Core::Real CoreSync::HistogramBucketLimitsMs[CoreSync::HistogramBucketCount - 1] = {1.0f, 2.0f, 4.0f, 8.0f, 16.0f, 33.0f};
+
+class CoreSync::Future::State {
+public:
+    enum class Status {
+        Queued,
+        Running,
+        Done,
+        Failed,
+        Cancelled
+    };
+
+    CoreSync* owner;
+    Runnable runnable;
+    Priority priority;
+    Tag tag;
+    QElapsedTimer waitTimer;
+
+    // guarded by mutex, as are the continuations still to be queued once this one has run
+    mutable QMutex mutex;
+    QWaitCondition finished;
+    Status status = Status::Queued;
+    std::vector<std::shared_ptr<State>> continuations;
+};
+
+CoreSync::Future::Future() {
+
+}
+
+Core::Bool CoreSync::Future::isValid() const {
+    return this->state != nullptr;
+}
+
+Core::Bool CoreSync::Future::isDone() const {
+    if (!this->state) return true;
+    QMutexLocker ml(&this->state->mutex);
+    return this->state->status == State::Status::Done || this->state->status == State::Status::Failed ||
+           this->state->status == State::Status::Cancelled;
+}
+
+Core::Bool CoreSync::Future::isCancelled() const {
+    if (!this->state) return false;
+    QMutexLocker ml(&this->state->mutex);
+    return this->state->status == State::Status::Cancelled;
+}
+
+Core::Bool CoreSync::Future::isFailed() const {
+    if (!this->state) return false;
+    QMutexLocker ml(&this->state->mutex);
+    return this->state->status == State::Status::Failed;
+}
+
+Core::Bool CoreSync::Future::cancel() {
+    if (!this->state) return false;
+    return this->state->owner->complete(this->state, true);
+}
+
+void CoreSync::Future::wait() const {
+    if (!this->state) return;
+    QMutexLocker ml(&this->state->mutex);
+    while (this->state->status == State::Status::Queued || this->state->status == State::Status::Running) {
+        this->state->finished.wait(&this->state->mutex);
+    }
+}
+
+CoreSync::Future CoreSync::Future::then(Runnable continuation, Priority priority) const {
+    Future future;
+    if (!this->state) return future;
+
+    future.state = std::make_shared<State>();
+    future.state->owner = this->state->owner;
+    future.state->runnable = continuation;
+    future.state->priority = priority;
+    future.state->tag = this->state->tag;
+
+    State::Status status;
+    {
+        QMutexLocker ml(&this->state->mutex);
+        status = this->state->status;
+        if (status == State::Status::Queued || status == State::Status::Running) {
+            this->state->continuations.push_back(future.state);
+            return future;
+        }
+    }
+    if (status == State::Status::Cancelled || status == State::Status::Failed) this->state->owner->complete(future.state, true);
+    else this->state->owner->enqueue(future.state);
+    return future;
+}
+
+Core::Bool CoreSync::Future::claim() {
+    if (!this->state) return false;
+    {
+        QMutexLocker ml(&this->state->mutex);
+        if (this->state->status != State::Status::Queued) return false;
+        this->state->status = State::Status::Running;
+    }
+    CoreSync* owner = this->state->owner;
+    QMutexLocker ml(&owner->runnablesMutex);
+    std::vector<std::shared_ptr<State>>::iterator itr = std::find(owner->tracked.begin(), owner->tracked.end(), this->state);
+    if (itr != owner->tracked.end()) owner->tracked.erase(itr);
+    return true;
+}
+
+void CoreSync::Future::finish(Core::Bool failed) {
+    if (!this->state) return;
+    this->state->owner->complete(this->state, false, failed);
+}
+
+Core::UInt32 CoreSync::Statistics::getQueueDepth() const {
+    Core::UInt32 depth = 0;
+    for (Core::UInt32 i = 0; i < PriorityCount; i++) depth += this->queued[i];
+    return depth;
+}
 
-CoreSync::CoreSync() {
+CoreSync::CoreSync(std::shared_ptr<FrameBudget> frameBudget): frameBudget(frameBudget) {
+    Core::Engine::instance()->onUpdate([this]() {
+        this->resolveRunnables();
+    }, true);
 }
 
 CoreSync::~CoreSync() {
 }
 
-void CoreSync::run(Runnable runnable) {
-    Core::Engine::LifecycleEventCallback temp = [runnable]() {
-        runnable(Core::Engine::instance());
-    };
-    Core::Engine::instance()->onUpdate(temp, false);
+CoreSync::Future CoreSync::run(Runnable runnable, Priority priority, Tag tag) {
+    Future future;
+    future.state = std::make_shared<Future::State>();
+    future.state->owner = this;
+    future.state->runnable = runnable;
+    future.state->priority = priority;
+    future.state->tag = tag;
+    this->enqueue(future.state);
+    return future;
+}
+
+CoreSync::Future CoreSync::track(Tag tag) {
+    Future future;
+    future.state = std::make_shared<Future::State>();
+    future.state->owner = this;
+    future.state->priority = Priority::Normal;
+    future.state->tag = tag;
+    QMutexLocker ml(&this->runnablesMutex);
+    this->tracked.push_back(future.state);
+    return future;
+}
+
+Core::UInt32 CoreSync::cancel(Tag tag) {
+    std::vector<std::shared_ptr<Future::State>> toCancel;
+    {
+        QMutexLocker ml(&this->runnablesMutex);
+        for (Core::UInt32 i = 0; i < PriorityCount; i++) {
+            for (std::shared_ptr<Future::State> state : this->runnables[i]) {
+                if (state->tag == tag) toCancel.push_back(state);
+            }
+        }
+        for (std::shared_ptr<Future::State> state : this->tracked) {
+            if (state->tag == tag) toCancel.push_back(state);
+        }
+    }
+    Core::UInt32 cancelled = 0;
+    for (std::shared_ptr<Future::State> state : toCancel) {
+        Future future;
+        future.state = state;
+        if (future.cancel()) cancelled++;
+    }
+    return cancelled;
+}
+
+CoreSync::Statistics CoreSync::getStatistics() {
+    QMutexLocker ml(&this->runnablesMutex);
+    Statistics statistics;
+    for (Core::UInt32 i = 0; i < PriorityCount; i++) statistics.queued[i] = this->runnables[i].size();
+    statistics.completed = this->completedCount;
+    statistics.cancelled = this->cancelledCount;
+    statistics.failed = this->failedCount;
+    statistics.averageWaitMs = this->waitedCount > 0 ? this->totalWaitMs / this->waitedCount : 0.0f;
+    statistics.maxWaitMs = this->maxWaitMs;
+    statistics.lastFrameMs = this->lastFrameMs;
+    for (Core::UInt32 i = 0; i < HistogramBucketCount; i++) statistics.frameHistogram[i] = this->frameHistogram[i];
+    statistics.rolledOverFrames = this->rolledOverFrames;
+    return statistics;
+}
+
+Core::UInt32 CoreSync::getQueueDepth() {
+    QMutexLocker ml(&this->runnablesMutex);
+    Core::UInt32 depth = 0;
+    for (Core::UInt32 i = 0; i < PriorityCount; i++) depth += this->runnables[i].size();
+    return depth;
+}
+
+void CoreSync::onQueued(QueuedCallback callback) {
+    QMutexLocker ml(&this->runnablesMutex);
+    this->queuedCallback = callback;
+}
+
+std::string CoreSync::formatHistogram(const Statistics& statistics) {
+    std::ostringstream ss;
+    for (Core::UInt32 i = 0; i < HistogramBucketCount; i++) {
+        if (i > 0) ss << ", ";
+        if (i < HistogramBucketCount - 1) ss << "<" << HistogramBucketLimitsMs[i] << " ms: ";
+        else ss << ">=" << HistogramBucketLimitsMs[i - 1] << " ms: ";
+        ss << statistics.frameHistogram[i];
+    }
+    return ss.str();
+}
+
+void CoreSync::enqueue(std::shared_ptr<Future::State> state) {
+    state->waitTimer.start();
+    QueuedCallback callback;
+    {
+        QMutexLocker ml(&this->runnablesMutex);
+        this->runnables[(Core::UInt32)state->priority].push_back(state);
+        callback = this->queuedCallback;
+    }
+    if (callback) callback();
+}
+
+void CoreSync::resolveRunnables() {
+    QElapsedTimer frameTimer;
+    frameTimer.start();
+
+    // anything queued while these run (continuations included) waits for the next update,
+    // so a runnable that keeps re-queueing itself can't stall the frame
+    std::vector<std::shared_ptr<Future::State>> toRun;
+    {
+        QMutexLocker ml(&this->runnablesMutex);
+        for (Core::UInt32 i = 0; i < PriorityCount; i++) {
+            toRun.insert(toRun.end(), this->runnables[i].begin(), this->runnables[i].end());
+            this->runnables[i].clear();
+        }
+    }
+
+    Core::Real budgetMs = this->frameBudget->getRemainingMs();
+    Core::UInt32 next = 0;
+    Core::UInt32 ranCount = 0;
+    for (; next < toRun.size(); next++) {
+        if (ranCount > 0 && frameTimer.nsecsElapsed() / 1000000.0 >= budgetMs) break;
+        std::shared_ptr<Future::State> state = toRun[next];
+        {
+            QMutexLocker ml(&state->mutex);
+            // cancelled after it was taken off the queue
+            if (state->status != Future::State::Status::Queued) continue;
+            state->status = Future::State::Status::Running;
+        }
+        Core::Real waitMs = state->waitTimer.nsecsElapsed() / 1000000.0;
+        {
+            QMutexLocker ml(&this->runnablesMutex);
+            this->waitedCount++;
+            this->totalWaitMs += waitMs;
+            this->maxWaitMs = std::max(this->maxWaitMs, waitMs);
+        }
+        // a throwing runnable must still finish, or wait() never returns and the rest of toRun is lost
+        Core::Bool failed = true;
+        try {
+            state->runnable(Core::Engine::instance());
+            failed = false;
+        }
+        catch (const Exception& ex) {
+            std::cout << "CoreSync::resolveRunnables() -> Runnable failed: " << ex.msg << std::endl;
+        }
+        catch (const std::exception& ex) {
+            std::cout << "CoreSync::resolveRunnables() -> Runnable failed: " << ex.what() << std::endl;
+        }
+        catch (...) {
+            std::cout << "CoreSync::resolveRunnables() -> Runnable failed with an unknown exception" << std::endl;
+        }
+        this->complete(state, false, failed);
+        ranCount++;
+    }
+
+    QMutexLocker ml(&this->runnablesMutex);
+    // over budget: the rest go back ahead of anything queued meanwhile, in their original order
+    for (Core::UInt32 i = toRun.size(); i > next; i--) {
+        std::shared_ptr<Future::State> state = toRun[i - 1];
+        QMutexLocker stateLocker(&state->mutex);
+        if (state->status == Future::State::Status::Queued) this->runnables[(Core::UInt32)state->priority].push_front(state);
+    }
+    if (next < toRun.size()) this->rolledOverFrames++;
+    Core::Real spentMs = frameTimer.nsecsElapsed() / 1000000.0;
+    this->frameBudget->consume(spentMs);
+    if (ranCount == 0) return;
+
+    this->lastFrameMs = spentMs;
+    Core::UInt32 bucket = 0;
+    while (bucket < HistogramBucketCount - 1 && this->lastFrameMs >= HistogramBucketLimitsMs[bucket]) bucket++;
+    this->frameHistogram[bucket]++;
+}
+
+Core::Bool CoreSync::complete(std::shared_ptr<Future::State> state, Core::Bool cancelled, Core::Bool failed) {
+    std::vector<std::shared_ptr<Future::State>> continuations;
+    {
+        QMutexLocker ml(&state->mutex);
+        // only queued runnables can be cancelled, one that already started always finishes
+        Future::State::Status expected = cancelled ? Future::State::Status::Queued : Future::State::Status::Running;
+        if (state->status != expected) return false;
+        if (cancelled) state->status = Future::State::Status::Cancelled;
+        else state->status = failed ? Future::State::Status::Failed : Future::State::Status::Done;
+        // the runnable's captures are released now rather than whenever the last Future goes away
+        state->runnable = Runnable();
+        continuations.swap(state->continuations);
+        state->finished.wakeAll();
+    }
+
+    {
+        QMutexLocker ml(&this->runnablesMutex);
+        if (cancelled) {
+            this->cancelledCount++;
+            std::deque<std::shared_ptr<Future::State>>& queue = this->runnables[(Core::UInt32)state->priority];
+            std::deque<std::shared_ptr<Future::State>>::iterator itr = std::find(queue.begin(), queue.end(), state);
+            if (itr != queue.end()) queue.erase(itr);
+            std::vector<std::shared_ptr<Future::State>>::iterator trackedItr = std::find(this->tracked.begin(), this->tracked.end(), state);
+            if (trackedItr != this->tracked.end()) this->tracked.erase(trackedItr);
+        }
+        else {
+            if (failed) this->failedCount++;
+            else this->completedCount++;
+        }
+    }
+
+    for (std::shared_ptr<Future::State> continuation : continuations) {
+        if (cancelled || failed) this->complete(continuation, true);
+        else this->enqueue(continuation);
+    }
+    return true;
 }
@@ -1,25 +1,132 @@
 #pragma once
 
+#include <atomic>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <string>
 #include <vector>
 
+#include <QElapsedTimer>
 #include <QMutex>
+#include <QWaitCondition>
 
 #include "Core/Engine.h"
 
+#include "Util/FrameBudget.h"
 
 // forward declarations
 class RenderWindow;
 
+// Render-thread task queue. Runnables can be queued from any thread and are drained at the
+// start of every engine update, highest priority first and in submission order within a
+// priority, until the shared FrameBudget is used up; the rest roll over to the next update.
+// Each one comes back as a Future the caller can wait on, chain from or cancel.
 class CoreSync final {
 public:
     typedef std::function<void(Core::WeakPointer<Core::Engine>)> Runnable;
+    // groups runnables so they can be cancelled together, 0 means ungrouped
+    typedef Core::UInt64 Tag;
+    typedef std::function<void()> QueuedCallback;
 
-    CoreSync();
+    enum class Priority {
+        // input & GUI responses the user is waiting on
+        High = 0,
+        Normal = 1,
+        // cache warming and anything else nobody is looking at yet
+        Low = 2
+    };
+    static const Core::UInt32 PriorityCount = 3;
+    // upper bounds (ms) of the per-frame histogram buckets, the last bucket is everything above
+    static const Core::UInt32 HistogramBucketCount = 7;
+    static const Core::Real HistogramBucketLimitsMs[HistogramBucketCount - 1];
+
+    class Future {
+    public:
+        Future();
+
+        Core::Bool isValid() const;
+        // true once the runnable has run, failed or been cancelled
+        Core::Bool isDone() const;
+        Core::Bool isCancelled() const;
+        // true if the runnable threw; its continuations are cancelled
+        Core::Bool isFailed() const;
+        // Returns true if the runnable was still queued; it then never runs and neither do its continuations.
+        Core::Bool cancel();
+        // Blocks until the runnable has run or been cancelled. Never call this on the render thread
+        // for a runnable that is still queued, it would wait on itself.
+        void wait() const;
+        // Queues continuation once this runnable has run (immediately if it already has).
+        // The continuation is cancelled along with this one.
+        Future then(Runnable continuation, Priority priority = Priority::Normal) const;
+
+        // For futures from CoreSync::track(), on the thread doing the work: claim() returns false
+        // if it was cancelled (the work should then be skipped), finish() reports the outcome.
+        Core::Bool claim();
+        void finish(Core::Bool failed = false);
+
+    private:
+        friend class CoreSync;
+        class State;
+        std::shared_ptr<State> state;
+    };
+
+    class Statistics {
+    public:
+        Core::UInt32 queued[PriorityCount] = {0, 0, 0};
+        // ran without throwing; the ones that threw only count as failed
+        Core::UInt64 completed = 0;
+        Core::UInt64 cancelled = 0;
+        Core::UInt64 failed = 0;
+        // time from submission to starting to run, over everything queued that has run so far
+        Core::Real averageWaitMs = 0.0f;
+        Core::Real maxWaitMs = 0.0f;
+        // render-thread time spent running the last frame's runnables
+        Core::Real lastFrameMs = 0.0f;
+        // frames that ran anything, by time spent (see HistogramBucketLimitsMs)
+        Core::UInt64 frameHistogram[HistogramBucketCount] = {0, 0, 0, 0, 0, 0, 0};
+        // frames that left runnables for the next one
+        Core::UInt64 rolledOverFrames = 0;
+
+        Core::UInt32 getQueueDepth() const;
+    };
+
+    // At least one runnable runs every frame however little of frameBudget is left, so the queue always moves.
+    CoreSync(std::shared_ptr<FrameBudget> frameBudget);
     ~CoreSync();
-    void run(Runnable runnable);
+    Future run(Runnable runnable, Priority priority = Priority::Normal, Tag tag = 0);
+    // A future for work that is scheduled elsewhere (e.g. a StreamingLoader load) but should be
+    // cancelled with tag like anything queued here. It is never run by CoreSync; see Future::claim().
+    Future track(Tag tag);
+    // Cancels every queued runnable submitted with tag, returns how many there were.
+    Core::UInt32 cancel(Tag tag);
+    Statistics getStatistics();
+    Core::UInt32 getQueueDepth();
+    // Called on the submitting thread whenever a runnable is queued, e.g. to wake an idle render loop.
+    void onQueued(QueuedCallback callback);
+    static std::string formatHistogram(const Statistics& statistics);
 
 private:
+    void enqueue(std::shared_ptr<Future::State> state);
+    void resolveRunnables();
+    Core::Bool complete(std::shared_ptr<Future::State> state, Core::Bool cancelled, Core::Bool failed = false);
 
+    // run() may be called from import worker threads, so runnables are queued here
+    // and drained on the render thread during the next engine update
+    QMutex runnablesMutex;
+    std::deque<std::shared_ptr<Future::State>> runnables[PriorityCount];
+    // from track(), until claimed or cancelled
+    std::vector<std::shared_ptr<Future::State>> tracked;
+    Core::UInt64 completedCount = 0;
+    Core::UInt64 cancelledCount = 0;
+    Core::UInt64 failedCount = 0;
+    // over the queued runnables that started, tracked futures aren't waiting on the queue
+    Core::UInt64 waitedCount = 0;
+    Core::Real totalWaitMs = 0.0f;
+    Core::Real maxWaitMs = 0.0f;
+    Core::Real lastFrameMs = 0.0f;
+    Core::UInt64 frameHistogram[HistogramBucketCount] = {0, 0, 0, 0, 0, 0, 0};
+    Core::UInt64 rolledOverFrames = 0;
+    std::shared_ptr<FrameBudget> frameBudget;
+    QueuedCallback queuedCallback;
 };
-
@@ -1,5 +1,6 @@
 #include "FlickerLight.h"
 #include "Core/util/Time.h"
+#include "Util/StartupTimeline.h"
 
 FlickerLight::FlickerLight() {
     this->lastIntensityFlickerTime = Core::Time::getTime();
@@ -7,6 +8,7 @@ FlickerLight::FlickerLight() {
     this->lastIntensityAdjuster = 1.0f;
     this->nextIntensityAdjuster = 1.0f;
     this->intensity = 1.0f;
+    this->generator.seed((std::minstd_rand::result_type)(Core::Math::random() * 2147483646.0f) + 1);
 }
 
 FlickerLight::FlickerLight(const FlickerLight& src) {
@@ -18,6 +20,7 @@ FlickerLight::FlickerLight(const FlickerLight& src) {
     this->lastIntensityAdjuster = src.lastIntensityAdjuster;
     this->nextIntensityAdjuster = src.nextIntensityAdjuster;
     this->lastPositionAdjuster = src.lastPositionAdjuster;
+    this->generator = src.generator;
 }
 
 FlickerLight& FlickerLight::operator = (const FlickerLight& other) {
@@ -30,11 +33,13 @@ FlickerLight& FlickerLight::operator = (const FlickerLight& other) {
     this->lastIntensityAdjuster = other.lastIntensityAdjuster;
     this->nextIntensityAdjuster = other.nextIntensityAdjuster;
     this->lastPositionAdjuster = other.lastPositionAdjuster;
+    this->generator = other.generator;
     return *this;
 }
 
 Core::WeakPointer<Core::PointLight> FlickerLight::create(Core::WeakPointer<Core::Object3D> parent, Core::Bool shadowsEnabled,
                                                          Core::UInt32 shadowMapSize, Core::Real constantShadowBias, Core::Real angularShadowBias) {
+    StartupTimeline::Scope timelineScope("FlickerLight::create");
     Core::WeakPointer<Core::Engine> engine = Core::Engine::instance();
     this->owner = engine->createObject3D();
     parent->addChild(this->owner);
@@ -51,8 +56,9 @@ void FlickerLight::setIntensity(Core::Real intensity) {
     this->intensity = intensity;
 }
 
-void FlickerLight::update() {
-    Core::Real time = Core::Time::getTime();
+void FlickerLight::simulate(Core::Real time, Core::Real deltaTime, State& state) {
+    state.intensityChanged = false;
+    state.positionChanged = false;
 
     Core::Real elapsedTimeSinceLastIntensityFlicker = time - this->lastIntensityFlickerTime;
     Core::Real flickerIntensityIntervalsPerSecond = 8.0f;
@@ -64,7 +70,7 @@ void FlickerLight::update() {
     if (elapsedTimeSinceLastIntensityFlicker > flickerIntensityIntervalLength) {
         this->lastIntensityFlickerTime = time;
 
-        Core::Real intensityDiff = (Core::Math::random() - 0.5f) * 2.0f * perUpdateIntervalIntensityFluxRange * flickerIntensityIntervalLength;
+        Core::Real intensityDiff = (this->random() - 0.5f) * 2.0f * perUpdateIntervalIntensityFluxRange * flickerIntensityIntervalLength;
 
         Core::Real intensityAdjuster = 1.0f + intensityDiff;
         Core::Real diff = (intensityAdjuster - this->lastIntensityAdjuster);
@@ -76,7 +82,8 @@ void FlickerLight::update() {
     } else {
         Core::Real elapsedFlickerIntensityT = elapsedTimeSinceLastIntensityFlicker / flickerIntensityIntervalLength;
         Core::Real intensityAdjuster = (1.0f - elapsedFlickerIntensityT) * this->lastIntensityAdjuster + elapsedFlickerIntensityT * this->nextIntensityAdjuster;
-        this->light->setIntensity(intensityAdjuster * this->intensity);
+        state.intensityChanged = true;
+        state.intensity = intensityAdjuster * this->intensity;
     }
 
 
@@ -87,18 +94,52 @@ void FlickerLight::update() {
     if (elapsedTimeSinceLastPositionFlicker > flickerPositionIntervalLength) {
         this->lastPositionFlickerTime = time;
 
-        Core::Real deltaTime = Core::Time::getDeltaTime();
-        Core::Vector3r positionAdjuster(Core::Math::random() - 0.5f, Core::Math::random() - 0.5f, Core::Math::random() - 0.5f);
+        Core::Vector3r positionAdjuster(this->random() - 0.5f, this->random() - 0.5f, this->random() - 0.5f);
         positionAdjuster.scale(deltaTime);
 
-        this->owner->getTransform().getLocalMatrix().setIdentity();
-        //this->owner->getTransform().translate(campFireLightLocalOffset, true);
-
         positionAdjuster.add(this->lastPositionAdjuster);
         positionAdjuster.scale(0.5f);
 
-        this->owner->getTransform().translate(positionAdjuster);
+        state.positionChanged = true;
+        state.position = positionAdjuster;
 
         this->lastPositionAdjuster = positionAdjuster;
     }
 }
+
+void FlickerLight::apply(const State& state) {
+    if (state.intensityChanged) this->light->setIntensity(state.intensity);
+    if (state.positionChanged) {
+        this->owner->getTransform().getLocalMatrix().setIdentity();
+        //this->owner->getTransform().translate(campFireLightLocalOffset, true);
+        this->owner->getTransform().translate(state.position);
+    }
+}
+
+Core::Real FlickerLight::random() {
+    return std::uniform_real_distribution<Core::Real>(0.0f, 1.0f)(this->generator);
+}
+
+void FlickerLightGroup::add(const FlickerLight& light) {
+    this->lights.push_back(light);
+}
+
+Core::UInt32 FlickerLightGroup::getCount() const {
+    return this->lights.size();
+}
+
+void FlickerLightGroup::simulate(Core::Real time, Core::Real deltaTime, Core::UInt32 slot) {
+    std::vector<FlickerLight::State>& states = this->states[slot];
+    states.resize(this->lights.size());
+    for (unsigned int i = 0; i < this->lights.size(); i++) {
+        this->lights[i].simulate(time, deltaTime, states[i]);
+    }
+}
+
+void FlickerLightGroup::applySimulation(Core::UInt32 slot) {
+    // apply() only reads the engine objects each light was created with, which simulate() never writes
+    const std::vector<FlickerLight::State>& states = this->states[slot];
+    for (unsigned int i = 0; i < states.size(); i++) {
+        this->lights[i].apply(states[i]);
+    }
+}
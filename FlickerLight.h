@@ -1,13 +1,27 @@
 #pragma once
 
+#include <random>
+#include <vector>
+
 #include "Core/Engine.h"
 #include "Core/scene/Object3D.h"
 #include "Core/light/PointLight.h"
 #include "Core/geometry/Vector3.h"
 
+#include "SimulationThread.h"
+
 class FlickerLight
 {
 public:
+    // One simulation step's changes to the light, applied on the render thread.
+    class State {
+    public:
+        Core::Bool intensityChanged = false;
+        Core::Real intensity = 0.0f;
+        Core::Bool positionChanged = false;
+        Core::Vector3r position;
+    };
+
     FlickerLight();
     FlickerLight(const FlickerLight& src);
     FlickerLight& operator = (const FlickerLight& other);
@@ -15,9 +29,12 @@ public:
                                                Core::UInt32 shadowMapSize, Core::Real constantShadowBias, Core::Real angularShadowBias);
     Core::WeakPointer<Core::PointLight> getLight();
     void setIntensity(Core::Real intensity);
-    void update();
+    // Touches no engine objects, so it can run on the simulation thread.
+    void simulate(Core::Real time, Core::Real deltaTime, State& state);
+    void apply(const State& state);
 
 private:
+     Core::Real random();
 
      Core::WeakPointer<Core::Object3D> owner;
      Core::WeakPointer<Core::PointLight> light;
@@ -29,4 +46,21 @@ private:
      Core::Real nextIntensityAdjuster;
      Core::Real intensity;
      Core::Vector3r lastPositionAdjuster;
+     // Core::Math::random() isn't safe to call off the render thread
+     std::minstd_rand generator;
+};
+
+// A scene's flicker lights as one simulation client, with a State per light in each slot.
+// Lights are added while the scene loads, before the group is handed to the SimulationThread.
+class FlickerLightGroup : public SimulationThread::Client {
+public:
+    void add(const FlickerLight& light);
+    Core::UInt32 getCount() const;
+
+    void simulate(Core::Real time, Core::Real deltaTime, Core::UInt32 slot) override;
+    void applySimulation(Core::UInt32 slot) override;
+
+private:
+    std::vector<FlickerLight> lights;
+    std::vector<FlickerLight::State> states[2];
 };
@@ -0,0 +1,88 @@
+#include <exception>
+#include <iostream>
+#include <sstream>
+
+#include <QThreadPool>
+
+#include "AnimationCache.h"
+#include "ModelImporter.h"
+#include "ModelBuilder.h"
+#include "Exception.h"
+#include "Util/StartupTimeline.h"
+
+AnimationCache::AnimationCache(std::shared_ptr<CoreSync> coreSync): coreSync(coreSync) {
+
+}
+
+void AnimationCache::load(const std::string& path, bool addLoopPadding, bool preserveFBXPivots, LoadCallback callback, CoreSync::Tag tag) {
+    std::string key = getKey(path, addLoopPadding, preserveFBXPivots);
+    Core::WeakPointer<Core::Animation> animation;
+    {
+        QMutexLocker ml(&this->entriesMutex);
+        Entry& entry = this->entries[key];
+        if (!entry.loaded) {
+            entry.pendingCallbacks.push_back(callback);
+            // only the first request for a clip starts loading it, later ones wait on it
+            if (entry.pendingCallbacks.size() == 1) {
+                QThreadPool::globalInstance()->start([this, key, path, addLoopPadding, preserveFBXPivots]() {
+                    this->parse(key, path, addLoopPadding, preserveFBXPivots);
+                });
+            }
+            return;
+        }
+        animation = entry.animation;
+    }
+    // someone is waiting on a clip that's ready, ahead of builds and other queued work
+    this->coreSync->run([callback, animation](Core::WeakPointer<Core::Engine> engine) {
+        callback(animation);
+    }, CoreSync::Priority::High, tag);
+}
+
+void AnimationCache::parse(const std::string& key, const std::string& path, bool addLoopPadding, bool preserveFBXPivots) {
+    StartupTimeline::Scope timelineScope("AnimationCache::parse " + path);
+    // a failed parse still goes through build() so the waiting callbacks hear about it
+    std::shared_ptr<AnimationDescription> description;
+    try {
+        description = ModelImporter::importAnimation(path, addLoopPadding, preserveFBXPivots);
+    }
+    catch (const Exception& ex) {
+        std::cout << "AnimationCache::parse() -> '" << path << "': " << ex.msg << std::endl;
+    }
+    catch (const std::exception& ex) {
+        std::cout << "AnimationCache::parse() -> '" << path << "': " << ex.what() << std::endl;
+    }
+
+    this->coreSync->run([this, key, path, description](Core::WeakPointer<Core::Engine> engine) {
+        this->build(engine, key, path, description);
+    });
+}
+
+void AnimationCache::build(Core::WeakPointer<Core::Engine> engine, const std::string& key, const std::string& path, std::shared_ptr<AnimationDescription> description) {
+    StartupTimeline::Scope timelineScope("AnimationCache::build " + path);
+    Core::WeakPointer<Core::Animation> animation;
+    if (description) animation = ModelBuilder::buildAnimation(engine, *description);
+
+    std::vector<LoadCallback> callbacks;
+    {
+        QMutexLocker ml(&this->entriesMutex);
+        Entry& entry = this->entries[key];
+        callbacks.swap(entry.pendingCallbacks);
+        // failed loads are forgotten so a later request can try again
+        if (animation.isValid()) {
+            entry.animation = animation;
+            entry.loaded = true;
+        } else {
+            std::cout << "AnimationCache::build() -> Unable to load '" << path << "'" << std::endl;
+            this->entries.erase(key);
+        }
+    }
+    for (LoadCallback callback : callbacks) {
+        callback(animation);
+    }
+}
+
+std::string AnimationCache::getKey(const std::string& path, bool addLoopPadding, bool preserveFBXPivots) {
+    std::ostringstream ss;
+    ss << path << "|" << addLoopPadding << "|" << preserveFBXPivots;
+    return ss.str();
+}
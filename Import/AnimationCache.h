@@ -0,0 +1,48 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <QMutex>
+
+#include "Core/Engine.h"
+#include "Core/animation/Animation.h"
+
+#include "CoreSync.h"
+#include "ModelDescription.h"
+
+// Caches animation clips by path + load options so every skeleton playing a clip shares
+// one Animation. The file is parsed into an AnimationDescription on a worker
+// (ModelImporter::importAnimation()); only creating the Core::Animation from it
+// (ModelBuilder::buildAnimation()) runs on the render thread, as a queued CoreSync
+// runnable rather than inside whatever callback asked for the clip.
+class AnimationCache {
+public:
+    using LoadCallback = std::function<void(Core::WeakPointer<Core::Animation>)>;
+
+    AnimationCache(std::shared_ptr<CoreSync> coreSync);
+
+    // Callable from any thread; the callback always runs on the render thread. For a clip that is
+    // already loaded it is queued on coreSync under tag, so cancelling the tag drops it.
+    void load(const std::string& path, bool addLoopPadding, bool preserveFBXPivots, LoadCallback callback, CoreSync::Tag tag = 0);
+
+    static std::string getKey(const std::string& path, bool addLoopPadding, bool preserveFBXPivots);
+
+private:
+    class Entry {
+    public:
+        Core::WeakPointer<Core::Animation> animation;
+        bool loaded = false;
+        std::vector<LoadCallback> pendingCallbacks;
+    };
+
+    void parse(const std::string& key, const std::string& path, bool addLoopPadding, bool preserveFBXPivots);
+    void build(Core::WeakPointer<Core::Engine> engine, const std::string& key, const std::string& path, std::shared_ptr<AnimationDescription> description);
+
+    std::shared_ptr<CoreSync> coreSync;
+    QMutex entriesMutex;
+    std::unordered_map<std::string, Entry> entries;
+};
@@ -0,0 +1,169 @@
+#include <iostream>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include "AssetDependencyGraph.h"
+#include "ModelCache.h"
+#include "Util/StartupTimeline.h"
+
+const Core::UInt32 AssetDependencyGraph::Magic = 0x47504544; // "DEPG"
+const Core::UInt32 AssetDependencyGraph::Version = 3;
+
+AssetDependencyGraph::AssetDependencyGraph() {
+
+}
+
+bool AssetDependencyGraph::load() {
+    QFile file(QString::fromStdString(getPath()));
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    StartupTimeline::addBytesRead(file.size());
+
+    QDataStream in(&file);
+    quint32 magic, version, resultCount;
+    in >> magic >> version >> resultCount;
+    if (in.status() != QDataStream::Ok || magic != Magic || version != Version) return false;
+
+    std::unordered_map<std::string, Result> loaded;
+    for (quint32 i = 0; i < resultCount; i++) {
+        QByteArray key, path;
+        Result result;
+        quint32 sourceCount;
+        in >> key >> path >> result.settings.scale >> result.settings.smoothingThreshold >> result.settings.castShadows
+           >> result.settings.preserveFBXPivots >> result.settings.usePhysicalMaterial >> result.settings.optimizeMeshes >> result.settings.blended
+           >> sourceCount;
+        if (in.status() != QDataStream::Ok) return false;
+        result.settings.path = path.toStdString();
+        result.sources.resize(sourceCount);
+        for (Source& source : result.sources) {
+            QByteArray sourcePath;
+            quint64 size;
+            qint64 modified;
+            in >> sourcePath >> size >> modified >> source.hash;
+            source.path = sourcePath.toStdString();
+            source.size = size;
+            source.modified = modified;
+        }
+        if (in.status() != QDataStream::Ok) return false;
+        loaded[key.toStdString()] = result;
+    }
+
+    QMutexLocker ml(&this->resultsMutex);
+    this->results.swap(loaded);
+    return true;
+}
+
+bool AssetDependencyGraph::save() {
+    QMutexLocker saveLock(&this->saveMutex);
+    QByteArray out;
+    {
+        QMutexLocker ml(&this->resultsMutex);
+        QDataStream stream(&out, QIODevice::WriteOnly);
+        stream << (quint32)Magic << (quint32)Version << (quint32)this->results.size();
+        for (const std::pair<const std::string, Result>& entry : this->results) {
+            const Result& result = entry.second;
+            stream << QByteArray::fromStdString(entry.first) << QByteArray::fromStdString(result.settings.path) << result.settings.scale
+                   << result.settings.smoothingThreshold << result.settings.castShadows << result.settings.preserveFBXPivots
+                   << result.settings.usePhysicalMaterial << result.settings.optimizeMeshes << result.settings.blended << (quint32)result.sources.size();
+            for (const Source& source : result.sources) {
+                stream << QByteArray::fromStdString(source.path) << (quint64)source.size << (qint64)source.modified << source.hash;
+            }
+        }
+    }
+
+    QString path = QString::fromStdString(getPath());
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(out) != out.size() || !file.commit()) {
+        std::cout << "AssetDependencyGraph::save() -> Unable to write " << path.toStdString() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+AssetDependencyGraph::State AssetDependencyGraph::check(const std::string& key) {
+    std::vector<Source> sources;
+    {
+        QMutexLocker ml(&this->resultsMutex);
+        std::unordered_map<std::string, Result>::iterator itr = this->results.find(key);
+        if (itr == this->results.end()) return State::Unknown;
+        sources = itr->second.sources;
+    }
+
+    // hashing happens outside the lock so results can be checked in parallel
+    Core::Bool restamped = false;
+    for (Source& source : sources) {
+        Source current;
+        current.path = source.path;
+        if (!readStamp(current)) return State::Stale;
+        if (current.size == source.size && current.modified == source.modified) continue;
+        if (current.size != source.size || !readHash(current) || current.hash != source.hash) return State::Stale;
+        // same content under a new stamp, remember it so the next check doesn't read the file again
+        source.modified = current.modified;
+        restamped = true;
+    }
+
+    if (restamped) {
+        QMutexLocker ml(&this->resultsMutex);
+        std::unordered_map<std::string, Result>::iterator itr = this->results.find(key);
+        if (itr != this->results.end()) itr->second.sources = sources;
+    }
+    return State::Current;
+}
+
+void AssetDependencyGraph::record(const ImportSettings& settings, const std::vector<std::string>& sourcePaths) {
+    Result result;
+    result.settings = settings;
+    for (const std::string& path : sourcePaths) {
+        Source source;
+        source.path = path;
+        // unreadable sources can't be verified later, so the result would never be current
+        if (!readStamp(source) || !readHash(source)) return;
+        result.sources.push_back(source);
+    }
+
+    QMutexLocker ml(&this->resultsMutex);
+    this->results[ModelCache::getKey(settings)] = result;
+}
+
+void AssetDependencyGraph::remove(const std::string& key) {
+    QMutexLocker ml(&this->resultsMutex);
+    this->results.erase(key);
+}
+
+std::vector<ImportSettings> AssetDependencyGraph::getResults() {
+    QMutexLocker ml(&this->resultsMutex);
+    std::vector<ImportSettings> settings;
+    for (const std::pair<const std::string, Result>& entry : this->results) {
+        settings.push_back(entry.second.settings);
+    }
+    return settings;
+}
+
+std::string AssetDependencyGraph::getPath() {
+    return (QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/models/dependencies.graph").toStdString();
+}
+
+bool AssetDependencyGraph::readStamp(Source& source) {
+    QFileInfo sourceInfo(QString::fromStdString(source.path));
+    if (!sourceInfo.exists()) return false;
+    source.size = sourceInfo.size();
+    source.modified = sourceInfo.lastModified().toMSecsSinceEpoch();
+    return true;
+}
+
+bool AssetDependencyGraph::readHash(Source& source) {
+    QFile file(QString::fromStdString(source.path));
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!hash.addData(&file)) return false;
+    StartupTimeline::addBytesRead(file.size());
+    source.hash = hash.result();
+    return true;
+}
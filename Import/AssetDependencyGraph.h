@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <QByteArray>
+#include <QMutex>
+
+#include "Core/common/types.h"
+
+#include "ModelDescription.h"
+
+// Records which source files (the model itself and every texture it resolved) and which
+// import settings produced each persisted import result, keyed by ModelCache::getKey().
+// A result is current while every source still has the content it was imported from:
+// sources whose size and modification time are unchanged are trusted without reading
+// them, anything else is re-hashed, so touching or copying a file doesn't force a re-import.
+//
+// Stored as a QDataStream: magic, version and result count, then per result the key, its
+// settings and its sources as (path, size, modified, SHA-1) records.
+class AssetDependencyGraph {
+public:
+    static const Core::UInt32 Magic;
+    static const Core::UInt32 Version;
+
+    enum class State {
+        Unknown,
+        Current,
+        Stale
+    };
+
+    AssetDependencyGraph();
+
+    // Replaces the in-memory graph with the one on disk; a missing or unreadable file leaves it empty.
+    bool load();
+    bool save();
+
+    // The methods below are callable from any thread.
+    State check(const std::string& key);
+    void record(const ImportSettings& settings, const std::vector<std::string>& sourcePaths);
+    void remove(const std::string& key);
+    std::vector<ImportSettings> getResults();
+
+    static std::string getPath();
+
+private:
+    class Source {
+    public:
+        std::string path;
+        Core::UInt64 size = 0;
+        Core::Int64 modified = 0;
+        QByteArray hash;
+    };
+
+    class Result {
+    public:
+        ImportSettings settings;
+        std::vector<Source> sources;
+    };
+
+    static bool readStamp(Source& source);
+    static bool readHash(Source& source);
+
+    // held for the whole of save(), so concurrent saves reach the disk in the order they were taken
+    QMutex saveMutex;
+    QMutex resultsMutex;
+    std::unordered_map<std::string, Result> results;
+};
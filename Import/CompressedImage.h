@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Core/common/types.h"
+
+#include "ModelDescription.h"
+
+// Block-compressed image with its full mip chain, ready to be handed to
+// glCompressedTexImage2D level by level (or glTexImage2D, for RGBA8).
+class CompressedImage {
+public:
+    enum class Format {
+        BC1 = 0,  // RGB, 8 bytes per 4x4 block, used for fully opaque images
+        BC3 = 1,  // RGBA, 16 bytes per 4x4 block
+        RGBA8 = 2 // uncompressed, for normal maps (BC1's 565 endpoints bend them) and GPUs without S3TC
+    };
+
+    class Level {
+    public:
+        Core::UInt32 width = 0;
+        Core::UInt32 height = 0;
+        DataArray<Core::Byte> data;
+    };
+
+    static Core::UInt32 getBlockSize(Format format) { return format == Format::BC1 ? 8 : 16; }
+    static Core::UInt32 getLevelSize(Format format, Core::UInt32 width, Core::UInt32 height) {
+        if (format == Format::RGBA8) return width * height * 4;
+        return ((width + 3) / 4) * ((height + 3) / 4) * getBlockSize(format);
+    }
+
+    Format format = Format::BC3;
+    Core::UInt32 width = 0;
+    Core::UInt32 height = 0;
+    std::vector<Level> levels;
+
+    // keeps externally owned level data alive, e.g. the mapped cache file
+    std::shared_ptr<void> backingStore;
+};
@@ -0,0 +1,227 @@
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QOpenGLContext>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include "CompressedTextureCache.h"
+#include "TextureCompressor.h"
+#include "Util/StartupTimeline.h"
+#include "ModelImporter.h"
+
+#include "Core/image/StandardImage.h"
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+const Core::UInt32 CompressedTextureCache::Magic = 0x58455443; // "CTEX"
+const Core::UInt32 CompressedTextureCache::Version = 1;
+const Core::UInt32 CompressedTextureCache::LevelAlignment = 16;
+std::unordered_map<std::string, Core::WeakPointer<Core::Texture2D>> CompressedTextureCache::residentTextures;
+std::atomic<Core::Bool> CompressedTextureCache::supportDetected(false);
+std::atomic<Core::Bool> CompressedTextureCache::blockCompressionSupported(true);
+
+CompressedTextureCache::CompressedTextureCache() {
+
+}
+
+std::shared_ptr<CompressedImage> CompressedTextureCache::load(const std::string& path, Core::Bool isNormalMap) {
+    Core::Bool uncompressed = isNormalMap || !blockCompressionSupported;
+    std::shared_ptr<CompressedImage> image = read(path, uncompressed);
+    if (image) return image;
+
+    std::shared_ptr<Core::StandardImage> decoded = ModelImporter::loadImage(path);
+    if (!decoded) return nullptr;
+    image = TextureCompressor::compress(*decoded, !uncompressed);
+    write(*image, path, uncompressed);
+    return image;
+}
+
+Core::WeakPointer<Core::Texture2D> CompressedTextureCache::buildTexture(Core::WeakPointer<Core::Engine> engine, const CompressedImage& image,
+                                                                        const Core::TextureAttributes& attributes) {
+    StartupTimeline::Scope timelineScope("CompressedTextureCache::buildTexture");
+    // Core has no compressed upload path, so the texture is built from a 1x1 placeholder
+    // (which also applies filter & wrap modes) and its storage is then replaced level by level
+    const Core::Byte white[4] = {255, 255, 255, 255};
+    Core::WeakPointer<Core::Texture2D> texture = createPlaceholderTexture(engine, attributes, white);
+    replaceImage(texture, image);
+    return texture;
+}
+
+Core::WeakPointer<Core::Texture2D> CompressedTextureCache::loadTexture(Core::WeakPointer<Core::Engine> engine, const std::string& path,
+                                                                       const Core::TextureAttributes& attributes) {
+    StartupTimeline::Scope timelineScope("CompressedTextureCache::loadTexture " + path);
+    detectBlockCompressionSupport();
+    std::ostringstream ss;
+    ss << path << "|" << (Core::UInt32)attributes.FilterMode << "|" << (Core::UInt32)attributes.WrapMode << "|" << attributes.MipLevels << "|"
+       << (Core::UInt32)attributes.Format;
+    std::string key = ss.str();
+    auto resident = residentTextures.find(key);
+    if (resident != residentTextures.end() && resident->second.isValid()) return resident->second;
+
+    std::shared_ptr<CompressedImage> image = load(path);
+    if (!image) {
+        std::cout << "CompressedTextureCache::loadTexture() -> Unable to load '" << path << "'" << std::endl;
+        return Core::WeakPointer<Core::Texture2D>();
+    }
+    Core::WeakPointer<Core::Texture2D> texture = buildTexture(engine, *image, attributes);
+    residentTextures[key] = texture;
+    return texture;
+}
+
+Core::WeakPointer<Core::Texture2D> CompressedTextureCache::createPlaceholderTexture(Core::WeakPointer<Core::Engine> engine, const Core::TextureAttributes& attributes,
+                                                                                    const Core::Byte color[4]) {
+    detectBlockCompressionSupport();
+    std::shared_ptr<Core::StandardImage> placeholder = std::make_shared<Core::StandardImage>(1, 1);
+    placeholder->init();
+    memcpy(placeholder->getImageData(), color, 4);
+    Core::WeakPointer<Core::Texture2D> texture = engine->getGraphicsSystem()->createTexture2D(attributes);
+    texture->buildFromImage(placeholder);
+    return texture;
+}
+
+void CompressedTextureCache::replaceImage(Core::WeakPointer<Core::Texture2D> texture, const CompressedImage& image) {
+    CompressedTextureCache uploader;
+    uploader.initializeOpenGLFunctions();
+    uploader.upload(texture, image);
+}
+
+void CompressedTextureCache::upload(Core::WeakPointer<Core::Texture2D> texture, const CompressedImage& image) {
+    // Core tracks what it has bound, so its binding is put back afterwards
+    GLint previousTexture = 0;
+    this->glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+    this->glBindTexture(GL_TEXTURE_2D, texture->getTextureID());
+    if (image.format == CompressedImage::Format::RGBA8) {
+        this->glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        for (Core::UInt32 i = 0; i < image.levels.size(); i++) {
+            const CompressedImage::Level& level = image.levels[i];
+            this->glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA8, level.width, level.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, level.data.data());
+        }
+    }
+    else {
+        GLenum internalFormat = image.format == CompressedImage::Format::BC1 ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        for (Core::UInt32 i = 0; i < image.levels.size(); i++) {
+            const CompressedImage::Level& level = image.levels[i];
+            this->glCompressedTexImage2D(GL_TEXTURE_2D, i, internalFormat, level.width, level.height, 0, level.data.size(), level.data.data());
+        }
+    }
+    this->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    this->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, image.levels.size() - 1);
+    this->glBindTexture(GL_TEXTURE_2D, previousTexture);
+}
+
+void CompressedTextureCache::detectBlockCompressionSupport() {
+    if (supportDetected) return;
+    QOpenGLContext* context = QOpenGLContext::currentContext();
+    if (context == nullptr) return;
+    blockCompressionSupported = context->hasExtension("GL_EXT_texture_compression_s3tc");
+    supportDetected = true;
+    if (!blockCompressionSupported) {
+        std::cout << "CompressedTextureCache -> GL_EXT_texture_compression_s3tc is not available, textures are cached uncompressed" << std::endl;
+    }
+}
+
+std::shared_ptr<CompressedImage> CompressedTextureCache::read(const std::string& path, Core::Bool uncompressed) {
+    Core::UInt64 sourceSize;
+    Core::Int64 sourceModified;
+    if (!getSourceStamp(path, sourceSize, sourceModified)) return nullptr;
+
+    std::shared_ptr<QFile> file = std::make_shared<QFile>(QString::fromStdString(getCachePath(path, uncompressed)));
+    if (!file->open(QIODevice::ReadOnly)) return nullptr;
+    Core::UInt64 fileSize = file->size();
+    const uchar* data = file->map(0, fileSize);
+    if (data == nullptr || fileSize < sizeof(FileHeader)) return nullptr;
+    StartupTimeline::addBytesRead(fileSize);
+
+    FileHeader header;
+    memcpy(&header, data, sizeof(FileHeader));
+    if (header.magic != Magic || header.version != Version) return nullptr;
+    if (header.format > (Core::UInt32)CompressedImage::Format::RGBA8) return nullptr;
+    if ((header.format == (Core::UInt32)CompressedImage::Format::RGBA8) != uncompressed) return nullptr;
+    if (header.sourceSize != sourceSize || header.sourceModified != sourceModified) return nullptr;
+    if (header.levelCount == 0 || fileSize < sizeof(FileHeader) + sizeof(LevelHeader) * header.levelCount) return nullptr;
+
+    std::shared_ptr<CompressedImage> image = std::make_shared<CompressedImage>();
+    image->format = (CompressedImage::Format)header.format;
+    image->width = header.width;
+    image->height = header.height;
+    image->backingStore = file;
+    image->levels.resize(header.levelCount);
+    for (Core::UInt32 i = 0; i < header.levelCount; i++) {
+        LevelHeader levelHeader;
+        memcpy(&levelHeader, data + sizeof(FileHeader) + sizeof(LevelHeader) * i, sizeof(LevelHeader));
+        if ((Core::UInt64)levelHeader.offset + levelHeader.size > fileSize) return nullptr;
+        if (levelHeader.size != CompressedImage::getLevelSize(image->format, levelHeader.width, levelHeader.height)) return nullptr;
+        CompressedImage::Level& level = image->levels[i];
+        level.width = levelHeader.width;
+        level.height = levelHeader.height;
+        level.data.setExternal(data + levelHeader.offset, levelHeader.size);
+    }
+    return image;
+}
+
+Core::Bool CompressedTextureCache::write(const CompressedImage& image, const std::string& path, Core::Bool uncompressed) {
+    FileHeader header;
+    header.magic = Magic;
+    header.version = Version;
+    if (!getSourceStamp(path, header.sourceSize, header.sourceModified)) return false;
+    header.format = (Core::UInt32)image.format;
+    header.width = image.width;
+    header.height = image.height;
+    header.levelCount = image.levels.size();
+
+    QByteArray out(getAlignedOffset(sizeof(FileHeader) + sizeof(LevelHeader) * header.levelCount), '\0');
+    memcpy(out.data(), &header, sizeof(FileHeader));
+    for (Core::UInt32 i = 0; i < header.levelCount; i++) {
+        const CompressedImage::Level& level = image.levels[i];
+        LevelHeader levelHeader;
+        levelHeader.width = level.width;
+        levelHeader.height = level.height;
+        levelHeader.offset = out.size();
+        levelHeader.size = level.data.size();
+        memcpy(out.data() + sizeof(FileHeader) + sizeof(LevelHeader) * i, &levelHeader, sizeof(LevelHeader));
+        out.append(reinterpret_cast<const char*>(level.data.data()), level.data.size());
+        out.resize(getAlignedOffset(out.size()));
+    }
+
+    QString cachePath = QString::fromStdString(getCachePath(path, uncompressed));
+    QDir().mkpath(QFileInfo(cachePath).absolutePath());
+    QSaveFile file(cachePath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(out) != out.size() || !file.commit()) {
+        std::cout << "CompressedTextureCache::write() -> Unable to write '" << cachePath.toStdString() << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::string CompressedTextureCache::getCachePath(const std::string& path, Core::Bool uncompressed) {
+    QString absolutePath = QFileInfo(QString::fromStdString(path)).absoluteFilePath();
+    QByteArray hash = QCryptographicHash::hash(absolutePath.toUtf8(), QCryptographicHash::Sha1).toHex();
+    QString directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/textures/";
+    return (directory + QString::fromLatin1(hash) + (uncompressed ? ".raw.ctex" : ".ctex")).toStdString();
+}
+
+Core::Bool CompressedTextureCache::getSourceStamp(const std::string& path, Core::UInt64& size, Core::Int64& modified) {
+    QFileInfo sourceInfo(QString::fromStdString(path));
+    if (!sourceInfo.exists()) return false;
+    size = sourceInfo.size();
+    modified = sourceInfo.lastModified().toMSecsSinceEpoch();
+    return true;
+}
+
+Core::UInt32 CompressedTextureCache::getAlignedOffset(Core::UInt32 offset) {
+    Core::UInt32 misalignment = offset % LevelAlignment;
+    return misalignment == 0 ? offset : offset + LevelAlignment - misalignment;
+}
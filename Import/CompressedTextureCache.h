@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <QOpenGLFunctions_3_3_Core>
+
+#include "Core/Engine.h"
+#include "Core/image/Texture2D.h"
+#include "Core/image/TextureAttr.h"
+
+#include "CompressedImage.h"
+
+// Disk cache of block-compressed textures with precomputed mip chains. The first load
+// of an image decodes and compresses it; later loads map the cached blocks, which
+// buildTexture() uploads as-is. Normal maps, and everything when the GL context lacks
+// GL_EXT_texture_compression_s3tc, keep their mip chains uncompressed (RGBA8) in a
+// separate entry.
+//
+// Layout (native byte order): a FileHeader, one LevelHeader per mip level, then the
+// level data, each level starting on a LevelAlignment boundary.
+class CompressedTextureCache: protected QOpenGLFunctions_3_3_Core {
+public:
+    static const Core::UInt32 Magic;
+    static const Core::UInt32 Version;
+    static const Core::UInt32 LevelAlignment;
+
+    CompressedTextureCache();
+
+    // Callable from any thread; returns nullptr if the image can't be decoded.
+    static std::shared_ptr<CompressedImage> load(const std::string& path, Core::Bool isNormalMap = false);
+
+    // Render thread only.
+    static Core::WeakPointer<Core::Texture2D> buildTexture(Core::WeakPointer<Core::Engine> engine, const CompressedImage& image,
+                                                           const Core::TextureAttributes& attributes);
+    // Textures loaded this way stay resident for the session; asking again for the same path and
+    // attributes returns the texture already on the GPU.
+    static Core::WeakPointer<Core::Texture2D> loadTexture(Core::WeakPointer<Core::Engine> engine, const std::string& path,
+                                                          const Core::TextureAttributes& attributes);
+    // A 1x1 texture of a single color whose storage replaceImage() later swaps out in place,
+    // so anything already bound to it picks up the real image without being touched.
+    static Core::WeakPointer<Core::Texture2D> createPlaceholderTexture(Core::WeakPointer<Core::Engine> engine, const Core::TextureAttributes& attributes,
+                                                                       const Core::Byte color[4]);
+    static void replaceImage(Core::WeakPointer<Core::Texture2D> texture, const CompressedImage& image);
+
+    static std::string getCachePath(const std::string& path, Core::Bool uncompressed);
+
+private:
+    class FileHeader {
+    public:
+        Core::UInt32 magic;
+        Core::UInt32 version;
+        Core::UInt64 sourceSize;
+        Core::Int64 sourceModified;
+        Core::UInt32 format;
+        Core::UInt32 width;
+        Core::UInt32 height;
+        Core::UInt32 levelCount;
+    };
+
+    class LevelHeader {
+    public:
+        Core::UInt32 width;
+        Core::UInt32 height;
+        Core::UInt32 offset;
+        Core::UInt32 size;
+    };
+
+    static std::shared_ptr<CompressedImage> read(const std::string& path, Core::Bool uncompressed);
+    static Core::Bool write(const CompressedImage& image, const std::string& path, Core::Bool uncompressed);
+    void upload(Core::WeakPointer<Core::Texture2D> texture, const CompressedImage& image);
+    // Render thread; decides the format load() produces from then on, so it runs before any
+    // texture is requested (createPlaceholderTexture(), loadTexture()). Without a context,
+    // e.g. in the asset baker, S3TC is assumed.
+    static void detectBlockCompressionSupport();
+
+    static Core::Bool getSourceStamp(const std::string& path, Core::UInt64& size, Core::Int64& modified);
+    static Core::UInt32 getAlignedOffset(Core::UInt32 offset);
+
+    static std::unordered_map<std::string, Core::WeakPointer<Core::Texture2D>> residentTextures;
+    static std::atomic<Core::Bool> supportDetected;
+    static std::atomic<Core::Bool> blockCompressionSupported;
+};
@@ -0,0 +1,242 @@
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include "CubeTextureCache.h"
+#include "Util/DevILLock.h"
+#include "Util/StartupTimeline.h"
+
+#include "Core/image/TextureUtils.h"
+#include "Core/image/StandardImage.h"
+#include "Core/image/HDRImage.h"
+
+const Core::UInt32 CubeTextureCache::Magic = 0x45425543; // "CUBE"
+const Core::UInt32 CubeTextureCache::Version = 2;
+const Core::UInt32 CubeTextureCache::FaceAlignment = 16;
+std::unordered_map<std::string, Core::WeakPointer<Core::CubeTexture>> CubeTextureCache::residentTextures;
+
+CubeTextureCache::CubeTextureCache() {
+
+}
+
+Core::TextureAttributes CubeTextureCache::getDefaultAttributes(Core::Bool isHDR) {
+    Core::TextureAttributes attributes;
+    attributes.FilterMode = Core::TextureFilter::Linear;
+    attributes.MipLevels = 2;
+    attributes.Format = isHDR ? Core::TextureFormat::RGBA16F : Core::TextureFormat::RGBA8;
+    return attributes;
+}
+
+Core::WeakPointer<Core::CubeTexture> CubeTextureCache::loadFromEquirectangularImage(Core::WeakPointer<Core::Engine> engine, const std::string& path,
+                                                                                    Core::Bool isHDR, Core::Real rotation) {
+    return loadFromEquirectangularImage(engine, path, isHDR, rotation, getDefaultAttributes(isHDR));
+}
+
+Core::WeakPointer<Core::CubeTexture> CubeTextureCache::loadFromEquirectangularImage(Core::WeakPointer<Core::Engine> engine, const std::string& path,
+                                                                                    Core::Bool isHDR, Core::Real rotation, const Core::TextureAttributes& attributes) {
+    StartupTimeline::Scope timelineScope("CubeTextureCache::loadFromEquirectangularImage " + path);
+    std::string key = getKey(path, isHDR, rotation, attributes);
+    auto resident = residentTextures.find(key);
+    if (resident != residentTextures.end() && resident->second.isValid()) return resident->second;
+
+    CubeTextureCache cache;
+    // reading and writing the faces both need 3.3 core, which e.g. the baker's offscreen context may not give
+    Core::Bool cacheUsable = cache.initializeOpenGLFunctions();
+    if (cacheUsable) {
+        Core::WeakPointer<Core::CubeTexture> cubeTexture = cache.read(engine, path, key, attributes);
+        if (cubeTexture.isValid()) {
+            residentTextures[key] = cubeTexture;
+            return cubeTexture;
+        }
+    }
+
+    Core::WeakPointer<Core::CubeTexture> converted;
+    {
+        StartupTimeline::Scope conversionScope("TextureUtils::loadFromEquirectangularImage");
+        StartupTimeline::addBytesRead(QFileInfo(QString::fromStdString(path)).size());
+        DevILLock devILLock;
+        converted = Core::TextureUtils::loadFromEquirectangularImage(path, isHDR, rotation);
+    }
+    if (!converted.isValid()) return converted;
+    if (!cacheUsable) {
+        std::cout << "CubeTextureCache::loadFromEquirectangularImage() -> OpenGL 3.3 core functions unavailable, not caching '" << path << "'" << std::endl;
+        residentTextures[key] = converted;
+        return converted;
+    }
+
+    // Core converts with attributes of its own choosing, so its texture is only the source: the
+    // faces are rebuilt from their cached encoding exactly as the next run will read them
+    QByteArray encoded;
+    if (!cache.encode(converted, path, key, isHDR, encoded)) {
+        std::cout << "CubeTextureCache::loadFromEquirectangularImage() -> Unable to read back '" << path << "', using Core's conversion as-is" << std::endl;
+        residentTextures[key] = converted;
+        return converted;
+    }
+    Core::Engine::safeReleaseObject(converted);
+    cache.write(encoded, key);
+    Core::WeakPointer<Core::CubeTexture> cubeTexture = cache.decode(engine, (const uchar*)encoded.constData(), encoded.size(), key, attributes);
+    if (cubeTexture.isValid()) residentTextures[key] = cubeTexture;
+    return cubeTexture;
+}
+
+Core::WeakPointer<Core::CubeTexture> CubeTextureCache::read(Core::WeakPointer<Core::Engine> engine, const std::string& path, const std::string& key,
+                                                            const Core::TextureAttributes& attributes) {
+    Core::UInt64 sourceSize;
+    Core::Int64 sourceModified;
+    if (!getSourceStamp(path, sourceSize, sourceModified)) return Core::WeakPointer<Core::CubeTexture>();
+
+    QFile file(QString::fromStdString(getCachePath(key)));
+    if (!file.open(QIODevice::ReadOnly)) return Core::WeakPointer<Core::CubeTexture>();
+    const uchar* data = file.map(0, file.size());
+    if (data == nullptr || (Core::UInt64)file.size() < sizeof(FileHeader)) return Core::WeakPointer<Core::CubeTexture>();
+    StartupTimeline::addBytesRead(file.size());
+
+    FileHeader header;
+    memcpy(&header, data, sizeof(FileHeader));
+    if (header.sourceSize != sourceSize || header.sourceModified != sourceModified) return Core::WeakPointer<Core::CubeTexture>();
+    return this->decode(engine, data, file.size(), key, attributes);
+}
+
+Core::Bool CubeTextureCache::encode(Core::WeakPointer<Core::CubeTexture> cubeTexture, const std::string& path, const std::string& key, Core::Bool isHDR,
+                                    QByteArray& out) {
+    FileHeader header;
+    header.magic = Magic;
+    header.version = Version;
+    if (!getSourceStamp(path, header.sourceSize, header.sourceModified)) return false;
+    header.isHDR = isHDR ? 1 : 0;
+    header.keyLength = key.size();
+    header.reserved = 0;
+
+    // Core tracks what it has bound, so its binding is put back afterwards
+    GLint previousTexture = 0;
+    this->glGetIntegerv(GL_TEXTURE_BINDING_CUBE_MAP, &previousTexture);
+    GLint faceSize = 0;
+    this->glBindTexture(GL_TEXTURE_CUBE_MAP, cubeTexture->getTextureID());
+    this->glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, GL_TEXTURE_WIDTH, &faceSize);
+    if (faceSize <= 0) {
+        this->glBindTexture(GL_TEXTURE_CUBE_MAP, previousTexture);
+        return false;
+    }
+    header.faceSize = faceSize;
+
+    Core::UInt32 faceBytes = header.faceSize * header.faceSize * 4;
+    out = QByteArray(getAlignedOffset(sizeof(FileHeader) + header.keyLength), '\0');
+    memcpy(out.data(), &header, sizeof(FileHeader));
+    memcpy(out.data() + sizeof(FileHeader), key.data(), key.size());
+    this->glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    for (Core::UInt32 i = 0; i < 6; i++) {
+        Core::UInt32 faceOffset = out.size();
+        out.resize(getAlignedOffset(faceOffset + faceBytes));
+        // GL packs the shared-exponent texels itself
+        if (isHDR) this->glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, GL_UNSIGNED_INT_5_9_9_9_REV, out.data() + faceOffset);
+        else this->glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, GL_UNSIGNED_BYTE, out.data() + faceOffset);
+    }
+    this->glBindTexture(GL_TEXTURE_CUBE_MAP, previousTexture);
+    return true;
+}
+
+Core::Bool CubeTextureCache::write(const QByteArray& encoded, const std::string& key) {
+    QString cachePath = QString::fromStdString(getCachePath(key));
+    QDir().mkpath(QFileInfo(cachePath).absolutePath());
+    QSaveFile file(cachePath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(encoded) != encoded.size() || !file.commit()) {
+        std::cout << "CubeTextureCache::write() -> Unable to write '" << cachePath.toStdString() << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+Core::WeakPointer<Core::CubeTexture> CubeTextureCache::decode(Core::WeakPointer<Core::Engine> engine, const uchar* data, Core::UInt64 size, const std::string& key,
+                                                              const Core::TextureAttributes& attributes) {
+    if (size < sizeof(FileHeader)) return Core::WeakPointer<Core::CubeTexture>();
+    FileHeader header;
+    memcpy(&header, data, sizeof(FileHeader));
+    if (header.magic != Magic || header.version != Version) return Core::WeakPointer<Core::CubeTexture>();
+    if (header.keyLength != key.size() || size < sizeof(FileHeader) + header.keyLength) return Core::WeakPointer<Core::CubeTexture>();
+    if (memcmp(data + sizeof(FileHeader), key.data(), key.size()) != 0) return Core::WeakPointer<Core::CubeTexture>();
+
+    Core::UInt32 faceBytes = header.faceSize * header.faceSize * 4;
+    const uchar* faces[6];
+    Core::UInt32 offset = getAlignedOffset(sizeof(FileHeader) + header.keyLength);
+    for (Core::UInt32 i = 0; i < 6; i++) {
+        if ((Core::UInt64)offset + faceBytes > size) return Core::WeakPointer<Core::CubeTexture>();
+        faces[i] = data + offset;
+        offset = getAlignedOffset(offset + faceBytes);
+    }
+
+    return this->buildFromFaces(engine, faces, header.faceSize, header.isHDR != 0, attributes);
+}
+
+Core::WeakPointer<Core::CubeTexture> CubeTextureCache::buildFromFaces(Core::WeakPointer<Core::Engine> engine, const uchar* faces[6], Core::UInt32 faceSize,
+                                                                      Core::Bool isHDR, const Core::TextureAttributes& attributes) {
+    Core::WeakPointer<Core::CubeTexture> cubeTexture = engine->createCubeTexture(attributes);
+
+    // CubeTexture takes its faces as front, back, top, bottom, left, right, which map to +Z, -Z, +Y, -Y, -X, +X
+    const Core::UInt32 faceOrder[6] = {4, 5, 2, 3, 1, 0};
+    Core::UInt32 texelCount = faceSize * faceSize;
+    if (isHDR) {
+        // Core only builds from float images, so it gets 1x1 placeholders to create the texture and
+        // its sampling state, then the packed faces go up as they are and stay RGB9E5 on the GPU
+        std::shared_ptr<Core::HDRImage> placeholders[6];
+        for (Core::UInt32 i = 0; i < 6; i++) {
+            placeholders[i] = std::make_shared<Core::HDRImage>(1, 1);
+            placeholders[i]->init();
+        }
+        cubeTexture->buildFromImages(placeholders[0], placeholders[1], placeholders[2], placeholders[3], placeholders[4], placeholders[5]);
+
+        // Core tracks what it has bound, so its binding is put back afterwards
+        GLint previousTexture = 0;
+        this->glGetIntegerv(GL_TEXTURE_BINDING_CUBE_MAP, &previousTexture);
+        this->glBindTexture(GL_TEXTURE_CUBE_MAP, cubeTexture->getTextureID());
+        this->glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        for (Core::UInt32 i = 0; i < 6; i++) {
+            this->glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB9_E5, faceSize, faceSize, 0, GL_RGB, GL_UNSIGNED_INT_5_9_9_9_REV, faces[i]);
+        }
+        if (attributes.MipLevels > 1) this->glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+        this->glBindTexture(GL_TEXTURE_CUBE_MAP, previousTexture);
+    } else {
+        std::shared_ptr<Core::StandardImage> images[6];
+        for (Core::UInt32 i = 0; i < 6; i++) {
+            images[i] = std::make_shared<Core::StandardImage>(faceSize, faceSize);
+            images[i]->init();
+            memcpy(images[i]->getImageData(), faces[faceOrder[i]], texelCount * 4);
+        }
+        cubeTexture->buildFromImages(images[0], images[1], images[2], images[3], images[4], images[5]);
+    }
+    return cubeTexture;
+}
+
+std::string CubeTextureCache::getKey(const std::string& path, Core::Bool isHDR, Core::Real rotation, const Core::TextureAttributes& attributes) {
+    std::ostringstream ss;
+    ss << path << "|" << isHDR << "|" << rotation << "|" << (Core::UInt32)attributes.FilterMode << "|" << attributes.MipLevels << "|"
+       << (Core::UInt32)attributes.Format;
+    return ss.str();
+}
+
+std::string CubeTextureCache::getCachePath(const std::string& key) {
+    QByteArray hash = QCryptographicHash::hash(QByteArray::fromStdString(key), QCryptographicHash::Sha1).toHex();
+    QString directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/skyboxes/";
+    return (directory + QString::fromLatin1(hash) + ".cube").toStdString();
+}
+
+Core::Bool CubeTextureCache::getSourceStamp(const std::string& path, Core::UInt64& size, Core::Int64& modified) {
+    QFileInfo sourceInfo(QString::fromStdString(path));
+    if (!sourceInfo.exists()) return false;
+    size = sourceInfo.size();
+    modified = sourceInfo.lastModified().toMSecsSinceEpoch();
+    return true;
+}
+
+Core::UInt32 CubeTextureCache::getAlignedOffset(Core::UInt32 offset) {
+    Core::UInt32 misalignment = offset % FaceAlignment;
+    return misalignment == 0 ? offset : offset + FaceAlignment - misalignment;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <QByteArray>
+#include <QOpenGLFunctions_3_3_Core>
+
+#include "Core/Engine.h"
+#include "Core/image/CubeTexture.h"
+#include "Core/image/TextureAttr.h"
+
+// Disk cache for equirectangular -> cube map conversions. The first load goes through
+// Core::TextureUtils and reads the resulting faces back from the GPU; later loads build
+// the CubeTexture straight from the cached faces without decoding or reprojecting.
+// Either way the texture handed out is built from the cached faces with the attributes
+// in the key, so the first run and later ones get the same thing. Render thread only,
+// since both paths need the current GL context. Converted textures also stay resident
+// for the session, so a scene switched back to gets its sky for free.
+//
+// Layout (native byte order): a FileHeader, the cache key, then six faces in GL target
+// order (+X, -X, +Y, -Y, +Z, -Z), each starting on a FaceAlignment boundary. HDR faces
+// are packed RGB9E5 (GL_UNSIGNED_INT_5_9_9_9_REV), a quarter of RGBA floats, which a
+// sky never needs the range or alpha of, and are uploaded as GL_RGB9_E5 without unpacking;
+// LDR faces are RGBA bytes. Both are 4 bytes a texel.
+class CubeTextureCache: protected QOpenGLFunctions_3_3_Core {
+public:
+    static const Core::UInt32 Magic;
+    static const Core::UInt32 Version;
+    static const Core::UInt32 FaceAlignment;
+
+    CubeTextureCache();
+
+    static Core::TextureAttributes getDefaultAttributes(Core::Bool isHDR);
+    static Core::WeakPointer<Core::CubeTexture> loadFromEquirectangularImage(Core::WeakPointer<Core::Engine> engine, const std::string& path, Core::Bool isHDR,
+                                                                             Core::Real rotation = 0.0f);
+    static Core::WeakPointer<Core::CubeTexture> loadFromEquirectangularImage(Core::WeakPointer<Core::Engine> engine, const std::string& path, Core::Bool isHDR,
+                                                                             Core::Real rotation, const Core::TextureAttributes& attributes);
+
+    static std::string getKey(const std::string& path, Core::Bool isHDR, Core::Real rotation, const Core::TextureAttributes& attributes);
+    static std::string getCachePath(const std::string& key);
+
+private:
+    class FileHeader {
+    public:
+        Core::UInt32 magic;
+        Core::UInt32 version;
+        Core::UInt64 sourceSize;
+        Core::Int64 sourceModified;
+        Core::UInt32 faceSize;
+        Core::UInt32 isHDR;
+        Core::UInt32 keyLength;
+        Core::UInt32 reserved;
+    };
+
+    Core::WeakPointer<Core::CubeTexture> read(Core::WeakPointer<Core::Engine> engine, const std::string& path, const std::string& key,
+                                             const Core::TextureAttributes& attributes);
+    // Reads the faces back into the on-disk layout.
+    Core::Bool encode(Core::WeakPointer<Core::CubeTexture> cubeTexture, const std::string& path, const std::string& key, Core::Bool isHDR, QByteArray& out);
+    Core::Bool write(const QByteArray& encoded, const std::string& key);
+    Core::WeakPointer<Core::CubeTexture> decode(Core::WeakPointer<Core::Engine> engine, const uchar* data, Core::UInt64 size, const std::string& key,
+                                               const Core::TextureAttributes& attributes);
+    Core::WeakPointer<Core::CubeTexture> buildFromFaces(Core::WeakPointer<Core::Engine> engine, const uchar* faces[6], Core::UInt32 faceSize,
+                                                       Core::Bool isHDR, const Core::TextureAttributes& attributes);
+
+    static Core::Bool getSourceStamp(const std::string& path, Core::UInt64& size, Core::Int64& modified);
+    static Core::UInt32 getAlignedOffset(Core::UInt32 offset);
+
+    static std::unordered_map<std::string, Core::WeakPointer<Core::CubeTexture>> residentTextures;
+};
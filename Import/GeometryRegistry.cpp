@@ -0,0 +1,142 @@
+#include <cstring>
+
+#include "GeometryRegistry.h"
+
+namespace {
+    const Core::UInt64 Prime1 = 0x9E3779B185EBCA87ull;
+    const Core::UInt64 Prime2 = 0xC2B2AE3D27D4EB4Full;
+
+    Core::UInt64 rotateLeft(Core::UInt64 value, Core::UInt32 bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    // word at a time, so hashing keeps up with reading the arrays
+    Core::UInt64 hashBytes(const void* data, size_t size, Core::UInt64 hash) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            Core::UInt64 word;
+            memcpy(&word, bytes + i, 8);
+            hash ^= rotateLeft(word * Prime2, 31) * Prime1;
+            hash = rotateLeft(hash, 27) * Prime1 + Prime2;
+        }
+        Core::UInt64 tail = 0;
+        if (i < size) memcpy(&tail, bytes + i, size - i);
+        hash ^= rotateLeft(tail * Prime2, 31) * Prime1;
+        hash ^= size;
+        hash ^= hash >> 33;
+        hash *= Prime2;
+        hash ^= hash >> 29;
+        return hash;
+    }
+
+    template <typename T>
+    Core::UInt64 hashArray(const DataArray<T>& array, Core::UInt64 hash) {
+        return hashBytes(array.data(), array.size() * sizeof(T), hash);
+    }
+
+    template <typename T>
+    void copyArray(const DataArray<T>& source, DataArray<T>& dest) {
+        dest.assign(std::vector<T>(source.data(), source.data() + source.size()));
+    }
+
+    template <typename T>
+    bool equalArrays(const DataArray<T>& a, const DataArray<T>& b) {
+        return a.size() == b.size() && (a.size() == 0 || memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+    }
+}
+
+GeometryRegistry::GeometryRegistry() {
+
+}
+
+Core::UInt64 GeometryRegistry::hash(const MeshDescription& mesh, Core::Real smoothingThreshold) {
+    Core::UInt64 hash = hashBytes(&mesh.vertexCount, sizeof(mesh.vertexCount), Prime1);
+    hash = hashArray(mesh.positions, hash);
+    hash = hashArray(mesh.normals, hash);
+    hash = hashArray(mesh.faceNormals, hash);
+    hash = hashArray(mesh.tangents, hash);
+    hash = hashArray(mesh.colors, hash);
+    hash = hashArray(mesh.uvs, hash);
+    hash = hashArray(mesh.indices, hash);
+    // without imported normals the builder smooths on the GPU side with the model's threshold
+    if (mesh.normals.size() == 0) hash = hashBytes(&smoothingThreshold, sizeof(smoothingThreshold), hash);
+    return hash;
+}
+
+Core::UInt64 GeometryRegistry::getByteSize(const MeshDescription& mesh) {
+    return (mesh.positions.size() + mesh.normals.size() + mesh.faceNormals.size() + mesh.tangents.size() + mesh.colors.size() + mesh.uvs.size()) *
+           sizeof(Core::Real) + mesh.indices.size() * sizeof(Core::UInt32);
+}
+
+Core::WeakPointer<Core::Mesh> GeometryRegistry::resolve(const MeshDescription& meshDescription, Core::Real smoothingThreshold, MeshFactory build) {
+    this->requestCount++;
+    std::vector<Entry>& candidates = this->entries[meshDescription.contentHash];
+    this->pruneEntries(candidates);
+    for (const Entry& candidate : candidates) {
+        if (isIdentical(candidate.geometry, candidate.smoothingThreshold, meshDescription, smoothingThreshold)) {
+            this->bytesSaved += getByteSize(meshDescription);
+            return candidate.mesh;
+        }
+    }
+
+    candidates.emplace_back();
+    Entry& entry = candidates.back();
+    copyGeometry(meshDescription, entry.geometry);
+    entry.smoothingThreshold = smoothingThreshold;
+    entry.mesh = build();
+    this->bytesRetained += getByteSize(entry.geometry);
+    this->uniqueCount++;
+    return entry.mesh;
+}
+
+void GeometryRegistry::prune() {
+    for (std::unordered_map<Core::UInt64, std::vector<Entry>>::iterator itr = this->entries.begin(); itr != this->entries.end();) {
+        if (this->pruneEntries(itr->second) == 0) itr = this->entries.erase(itr);
+        else ++itr;
+    }
+}
+
+size_t GeometryRegistry::pruneEntries(std::vector<Entry>& candidates) {
+    for (std::vector<Entry>::iterator itr = candidates.begin(); itr != candidates.end();) {
+        if (itr->mesh.isValid()) {
+            ++itr;
+            continue;
+        }
+        this->bytesRetained -= getByteSize(itr->geometry);
+        itr = candidates.erase(itr);
+    }
+    return candidates.size();
+}
+
+Core::UInt32 GeometryRegistry::getUniqueCount() const {
+    return this->uniqueCount;
+}
+
+Core::UInt32 GeometryRegistry::getRequestCount() const {
+    return this->requestCount;
+}
+
+Core::Int64 GeometryRegistry::getBytesSaved() const {
+    return (Core::Int64)this->bytesSaved - (Core::Int64)this->bytesRetained;
+}
+
+void GeometryRegistry::copyGeometry(const MeshDescription& source, MeshDescription& dest) {
+    dest.vertexCount = source.vertexCount;
+    dest.contentHash = source.contentHash;
+    copyArray(source.positions, dest.positions);
+    copyArray(source.normals, dest.normals);
+    copyArray(source.faceNormals, dest.faceNormals);
+    copyArray(source.tangents, dest.tangents);
+    copyArray(source.colors, dest.colors);
+    copyArray(source.uvs, dest.uvs);
+    copyArray(source.indices, dest.indices);
+}
+
+bool GeometryRegistry::isIdentical(const MeshDescription& aMesh, Core::Real aSmoothingThreshold, const MeshDescription& bMesh, Core::Real bSmoothingThreshold) {
+    if (aMesh.vertexCount != bMesh.vertexCount) return false;
+    if (aMesh.normals.size() == 0 && aSmoothingThreshold != bSmoothingThreshold) return false;
+    return equalArrays(aMesh.positions, bMesh.positions) && equalArrays(aMesh.normals, bMesh.normals) && equalArrays(aMesh.faceNormals, bMesh.faceNormals) &&
+           equalArrays(aMesh.tangents, bMesh.tangents) && equalArrays(aMesh.colors, bMesh.colors) && equalArrays(aMesh.uvs, bMesh.uvs) &&
+           equalArrays(aMesh.indices, bMesh.indices);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/Engine.h"
+#include "Core/geometry/Mesh.h"
+
+#include "ModelDescription.h"
+
+// Resolves bit-identical geometry from different imports (modular kit pieces exported into
+// several files, the same prop in two FBXs...) to one GPU Mesh. Every stream is hashed on the
+// worker when a model is parsed; the render thread only compares meshes with equal hashes
+// byte for byte before sharing one. The registry keeps its own copy of each live mesh's
+// arrays to compare against (not the model they came from), and drops it once the mesh is
+// released.
+class GeometryRegistry {
+public:
+    using MeshFactory = std::function<Core::WeakPointer<Core::Mesh>()>;
+
+    GeometryRegistry();
+
+    // Callable from any thread. Covers everything buildMesh() reads, so meshes with equal
+    // hashes that also compare equal produce identical GPU meshes.
+    static Core::UInt64 hash(const MeshDescription& mesh, Core::Real smoothingThreshold);
+    static Core::UInt64 getByteSize(const MeshDescription& mesh);
+
+    // Render thread only. Returns the mesh already built for identical geometry, otherwise
+    // the one build() creates. meshDescription must have its contentHash set.
+    Core::WeakPointer<Core::Mesh> resolve(const MeshDescription& meshDescription, Core::Real smoothingThreshold, MeshFactory build);
+    // Render thread only. Forgets meshes that have been released since.
+    void prune();
+
+    Core::UInt32 getUniqueCount() const;
+    Core::UInt32 getRequestCount() const;
+    // vertex & index bytes that would have been uploaded again without sharing, less what the
+    // registry holds on to for comparing; negative while that outweighs what was shared
+    Core::Int64 getBytesSaved() const;
+
+private:
+    class Entry {
+    public:
+        // owned copies of the arrays buildMesh() read, a model's own may point into a mapped file
+        MeshDescription geometry;
+        Core::Real smoothingThreshold;
+        Core::WeakPointer<Core::Mesh> mesh;
+    };
+
+    // erases entries whose mesh is gone, returns how many are left
+    size_t pruneEntries(std::vector<Entry>& candidates);
+    static void copyGeometry(const MeshDescription& source, MeshDescription& dest);
+    static bool isIdentical(const MeshDescription& a, Core::Real aSmoothingThreshold, const MeshDescription& b, Core::Real bSmoothingThreshold);
+
+    std::unordered_map<Core::UInt64, std::vector<Entry>> entries;
+    Core::UInt32 uniqueCount = 0;
+    Core::UInt32 requestCount = 0;
+    Core::UInt64 bytesSaved = 0;
+    // held by entries
+    Core::UInt64 bytesRetained = 0;
+};
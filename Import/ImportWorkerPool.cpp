@@ -0,0 +1,217 @@
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <unordered_map>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QProcess>
+#include <QSharedMemory>
+#include <QThreadStorage>
+
+#include "ImportWorkerPool.h"
+#include "ModelImporter.h"
+#include "ModelBinaryCache.h"
+#include "MeshOptimizer.h"
+#include "Exception.h"
+
+const char* ImportWorkerPool::WorkerArgument = "--import-worker";
+const char* ImportWorkerPool::MeasureOverdrawArgument = "--measure-overdraw";
+const char* ImportWorkerPool::ReplyPrefix = "@import-worker ";
+
+QMutex ImportWorkerPool::executableMutex;
+std::string ImportWorkerPool::executable;
+
+// One helper process, used only by the pool thread that started it: QProcess has thread
+// affinity, and without an event loop on the pool threads all I/O goes through its waitFor*() calls.
+class ImportWorkerPool::Worker {
+public:
+    ~Worker() {
+        if (this->process.state() == QProcess::NotRunning) return;
+        this->process.closeWriteChannel();
+        if (!this->process.waitForFinished(1000)) {
+            this->process.kill();
+            this->process.waitForFinished();
+        }
+    }
+
+    bool start(const std::string& executable) {
+        if (this->process.state() == QProcess::Running) return true;
+        this->process.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+        QStringList arguments = QStringList() << WorkerArgument;
+        if (MeshOptimizer::isOverdrawMeasured()) arguments << MeasureOverdrawArgument;
+        this->process.start(QString::fromStdString(executable), arguments);
+        if (!this->process.waitForStarted()) {
+            std::cout << "ImportWorkerPool -> Unable to start '" << executable << "': " << this->process.errorString().toStdString() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    std::shared_ptr<ModelDescription> import(const ImportSettings& settings) {
+        static std::atomic<Core::UInt32> nextSegment(0);
+        QByteArray segment = QString("modeler-import-%1-%2").arg(QCoreApplication::applicationPid()).arg(nextSegment++).toUtf8();
+
+        QByteArray request = "import\t" + segment + "\t" + QByteArray::number(settings.scale, 'g', 9) + "\t" +
+                             QByteArray::number(settings.smoothingThreshold, 'g', 9) + "\t" + QByteArray::number(settings.castShadows ? 1 : 0) + "\t" +
+                             QByteArray::number(settings.preserveFBXPivots ? 1 : 0) + "\t" + QByteArray::number(settings.usePhysicalMaterial ? 1 : 0) + "\t" +
+                             QByteArray::number(settings.optimizeMeshes ? 1 : 0) + "\t" + QByteArray::number(settings.blended ? 1 : 0) + "\t" +
+                             QByteArray::fromStdString(settings.path) + "\n";
+        QByteArray reply;
+        if (!this->send(request) || !this->readReply(reply)) {
+            throw Exception("Import worker exited while importing '" + settings.path + "'");
+        }
+        if (reply.startsWith("error ")) {
+            throw Exception(reply.mid(6).toStdString());
+        }
+
+        QList<QByteArray> fields = reply.split(' ');
+        if (fields.size() != 3 || fields[0] != "ok" || fields[1] != segment) {
+            throw Exception("Unexpected reply from import worker: '" + reply.toStdString() + "'");
+        }
+        Core::UInt64 size = fields[2].toULongLong();
+
+        std::shared_ptr<QSharedMemory> memory = std::make_shared<QSharedMemory>(QString::fromUtf8(segment));
+        bool attached = memory->attach(QSharedMemory::ReadOnly);
+        // the worker can drop its handle either way, ours keeps the segment alive for as long as the description needs it
+        this->send("release\t" + segment + "\n");
+        if (!attached || size > (Core::UInt64)memory->size()) {
+            throw Exception("Unable to map the import result of '" + settings.path + "': " + memory->errorString().toStdString());
+        }
+
+        std::shared_ptr<ModelDescription> description = ModelBinaryCache::deserialize(static_cast<const uchar*>(memory->constData()), size, settings, memory);
+        if (!description) {
+            throw Exception("Malformed import result for '" + settings.path + "'");
+        }
+        return description;
+    }
+
+private:
+    bool send(const QByteArray& line) {
+        if (this->process.write(line) != line.size()) return false;
+        while (this->process.bytesToWrite() > 0) {
+            if (!this->process.waitForBytesWritten(-1)) return false;
+        }
+        return true;
+    }
+
+    bool readReply(QByteArray& reply) {
+        const Core::UInt32 prefixLength = strlen(ReplyPrefix);
+        while (true) {
+            while (!this->process.canReadLine()) {
+                if (!this->process.waitForReadyRead(-1)) return false;
+            }
+            QByteArray line = this->process.readLine();
+            if (line.endsWith('\n')) line.chop(1);
+            if (!line.startsWith(ReplyPrefix)) {
+                // the importer's own logging
+                std::cout << line.toStdString() << std::endl;
+                continue;
+            }
+            reply = line.mid(prefixLength);
+            return true;
+        }
+    }
+
+    QProcess process;
+};
+
+void ImportWorkerPool::setWorkerExecutable(const std::string& path) {
+    QMutexLocker ml(&executableMutex);
+    executable = path;
+}
+
+bool ImportWorkerPool::isEnabled() {
+    QMutexLocker ml(&executableMutex);
+    return executable.size() > 0;
+}
+
+std::shared_ptr<ModelDescription> ImportWorkerPool::import(const ImportSettings& settings) {
+    std::string workerExecutable;
+    {
+        QMutexLocker ml(&executableMutex);
+        workerExecutable = executable;
+    }
+    if (workerExecutable.size() == 0) return nullptr;
+
+    // deleted along with the pool thread, which also shuts its worker down
+    static QThreadStorage<Worker*> workers;
+    if (!workers.hasLocalData()) workers.setLocalData(new Worker());
+    Worker* worker = workers.localData();
+    if (!worker->start(workerExecutable)) return nullptr;
+    return worker->import(settings);
+}
+
+int ImportWorkerPool::serve() {
+    QFile input;
+    if (!input.open(stdin, QIODevice::ReadOnly)) return 1;
+
+    auto reply = [](const std::string& message) {
+        std::string line = message;
+        for (char& c : line) {
+            if (c == '\n' || c == '\r') c = ' ';
+        }
+        std::cout << ReplyPrefix << line << std::endl;
+    };
+
+    // segments stay mapped here until the editor has attached to them
+    std::unordered_map<std::string, std::unique_ptr<QSharedMemory>> segments;
+    while (true) {
+        QByteArray line = input.readLine();
+        if (line.isEmpty()) break;
+        if (line.endsWith('\n')) line.chop(1);
+
+        QList<QByteArray> fields = line.split('\t');
+        if (fields.size() == 2 && fields[0] == "release") {
+            segments.erase(fields[1].toStdString());
+            continue;
+        }
+        if (fields.size() != 10 || fields[0] != "import") {
+            reply("error Malformed request '" + line.toStdString() + "'");
+            continue;
+        }
+
+        std::string segment = fields[1].toStdString();
+        ImportSettings settings;
+        settings.scale = fields[2].toFloat();
+        settings.smoothingThreshold = fields[3].toFloat();
+        settings.castShadows = fields[4] == "1";
+        settings.preserveFBXPivots = fields[5] == "1";
+        settings.usePhysicalMaterial = fields[6] == "1";
+        settings.optimizeMeshes = fields[7] == "1";
+        settings.blended = fields[8] == "1";
+        settings.path = fields[9].toStdString();
+
+        QByteArray image;
+        try {
+            std::shared_ptr<ModelDescription> description = ModelImporter::importModel(settings);
+            if (!ModelBinaryCache::serialize(*description, image)) throw Exception("'" + settings.path + "' disappeared during import");
+            ModelBinaryCache::write(*description);
+        }
+        catch (const Exception& ex) {
+            reply("error " + ex.msg);
+            continue;
+        }
+        catch (const std::exception& ex) {
+            reply("error " + std::string(ex.what()));
+            continue;
+        }
+        catch (...) {
+            reply("error Unknown exception importing '" + settings.path + "'");
+            continue;
+        }
+
+        std::unique_ptr<QSharedMemory> memory(new QSharedMemory(QString::fromStdString(segment)));
+        if (!memory->create(image.size())) {
+            reply("error Unable to create shared memory for '" + settings.path + "': " + memory->errorString().toStdString());
+            continue;
+        }
+        memory->lock();
+        memcpy(memory->data(), image.constData(), image.size());
+        memory->unlock();
+        segments[segment] = std::move(memory);
+        reply("ok " + segment + " " + std::to_string(image.size()));
+    }
+    return 0;
+}
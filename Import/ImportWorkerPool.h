@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <QMutex>
+
+#include "Core/common/types.h"
+
+#include "ModelDescription.h"
+
+// Runs model imports in helper processes (the asset baker started with WorkerArgument), so
+// Assimp's many short-lived allocations never touch the editor's heap and a crashing import
+// only loses the model being imported. Each pool thread that imports gets a worker of its
+// own, restarted if it dies.
+//
+// Protocol, one line each way over the worker's stdin/stdout:
+//   -> import <segment> <scale> <smoothingThreshold> <castShadows> <preserveFBXPivots> <usePhysicalMaterial> <optimizeMeshes> <blended> <path>
+//   <- @import-worker ok <segment> <size>      or      @import-worker error <message>
+//   -> release <segment>
+// (fields tab separated). On success the worker has written the result, in ModelBinaryCache's
+// layout, to a QSharedMemory segment, and has baked it to disk. The returned description's mesh
+// arrays point straight into that segment. Anything else the worker prints is passed through.
+class ImportWorkerPool {
+public:
+    static const char* WorkerArgument;
+    // passed along to workers while MeshOptimizer::isOverdrawMeasured(), so their imports log it too
+    static const char* MeasureOverdrawArgument;
+    static const char* ReplyPrefix;
+
+    // Enables the pool; with no executable set (the default) import() always returns nullptr.
+    static void setWorkerExecutable(const std::string& path);
+    static bool isEnabled();
+
+    // Callable from any thread except the GUI thread; blocks until the worker replies. Returns
+    // nullptr if no worker could be started, so the caller can fall back to importing in-process.
+    // Throws Exception if the import fails or the worker dies during it.
+    static std::shared_ptr<ModelDescription> import(const ImportSettings& settings);
+
+    // Worker side: serves requests from stdin until it is closed. Returns the process exit code.
+    static int serve();
+
+private:
+    class Worker;
+
+    static QMutex executableMutex;
+    static std::string executable;
+};
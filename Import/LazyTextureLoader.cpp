@@ -0,0 +1,48 @@
+#include <iostream>
+
+#include <QThreadPool>
+
+#include "LazyTextureLoader.h"
+#include "CompressedTextureCache.h"
+#include "Util/StartupTimeline.h"
+
+LazyTextureLoader::LazyTextureLoader(std::shared_ptr<FrameBudget> frameBudget): streamer(frameBudget) {
+
+}
+
+Core::WeakPointer<Core::Texture2D> LazyTextureLoader::load(Core::WeakPointer<Core::Engine> engine, const std::string& path,
+                                                           const Core::TextureAttributes& attributes, Placeholder placeholder) {
+    // white leaves albedo untouched, (0.5, 0.5, 1) is an unperturbed tangent-space normal
+    const Core::Byte white[4] = {255, 255, 255, 255};
+    const Core::Byte flatNormal[4] = {128, 128, 255, 255};
+    Core::WeakPointer<Core::Texture2D> texture =
+            CompressedTextureCache::createPlaceholderTexture(engine, attributes, placeholder == Placeholder::FlatNormal ? flatNormal : white);
+
+    Core::Bool isNormalMap = placeholder == Placeholder::FlatNormal;
+    this->streamer.request([path, texture, isNormalMap](StreamingLoader::ReadyCallback ready) {
+        QThreadPool::globalInstance()->start([path, texture, isNormalMap, ready]() {
+            std::shared_ptr<CompressedImage> image = CompressedTextureCache::load(path, isNormalMap);
+            if (!image) {
+                std::cout << "LazyTextureLoader::load() -> Unable to load '" << path << "', keeping placeholder" << std::endl;
+                ready([](Core::WeakPointer<Core::Engine> engine) {});
+                return;
+            }
+
+            ready([path, texture, image](Core::WeakPointer<Core::Engine> engine) {
+                // the model may have been removed while the image was decoding
+                if (!texture.isValid()) return;
+                StartupTimeline::Scope timelineScope("LazyTextureLoader upload " + path);
+                CompressedTextureCache::replaceImage(texture, *image);
+            });
+        });
+    });
+    return texture;
+}
+
+void LazyTextureLoader::update(Core::WeakPointer<Core::Engine> engine) {
+    this->streamer.update(engine, Core::Point3r());
+}
+
+Core::UInt32 LazyTextureLoader::getOutstandingCount() {
+    return this->streamer.getOutstandingCount();
+}
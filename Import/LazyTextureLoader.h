@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+
+#include "Core/Engine.h"
+#include "Core/image/Texture2D.h"
+#include "Core/image/TextureAttr.h"
+
+#include "StreamingLoader.h"
+
+// Hands out textures that can be bound immediately and fills them in later. Each texture
+// starts as a 1x1 placeholder; the real image is decoded (or read from
+// CompressedTextureCache) on the thread pool and uploaded into the same texture object
+// out of whatever the shared FrameBudget has left, so models show up as soon as their
+// geometry is built and texture uploads are spread across frames instead of stalling one.
+class LazyTextureLoader {
+public:
+    enum class Placeholder {
+        White = 0,
+        FlatNormal = 1
+    };
+
+    LazyTextureLoader(std::shared_ptr<FrameBudget> frameBudget);
+
+    // Render thread only.
+    Core::WeakPointer<Core::Texture2D> load(Core::WeakPointer<Core::Engine> engine, const std::string& path,
+                                            const Core::TextureAttributes& attributes, Placeholder placeholder);
+    // Render thread, once per frame.
+    void update(Core::WeakPointer<Core::Engine> engine);
+
+    Core::UInt32 getOutstandingCount();
+
+private:
+    StreamingLoader streamer;
+};
@@ -0,0 +1,97 @@
+#include <cstring>
+
+#include <QFileInfo>
+
+#include "MappedIOSystem.h"
+#include "Util/StartupTimeline.h"
+
+MappedIOSystem::MappedIOSystem() {
+
+}
+
+bool MappedIOSystem::Exists(const char* path) const {
+    return QFileInfo(QString::fromUtf8(path)).isFile();
+}
+
+char MappedIOSystem::getOsSeparator() const {
+    // Qt accepts '/' on every platform
+    return '/';
+}
+
+Assimp::IOStream* MappedIOSystem::Open(const char* path, const char* mode) {
+    if (strchr(mode, 'w') != nullptr || strchr(mode, 'a') != nullptr || strchr(mode, '+') != nullptr) {
+        return this->fallback.Open(path, mode);
+    }
+
+    std::unique_ptr<QFile> file(new QFile(QString::fromUtf8(path)));
+    if (!file->open(QIODevice::ReadOnly)) return nullptr;
+    qint64 size = file->size();
+    // empty files can't be mapped
+    if (size <= 0) return this->fallback.Open(path, mode);
+    const uchar* data = file->map(0, size);
+    if (data == nullptr) return this->fallback.Open(path, mode);
+
+    StartupTimeline::addBytesRead(size);
+    return new MappedIOStream(std::move(file), data, (size_t)size);
+}
+
+void MappedIOSystem::Close(Assimp::IOStream* stream) {
+    if (dynamic_cast<MappedIOStream*>(stream) != nullptr) {
+        delete stream;
+    } else {
+        this->fallback.Close(stream);
+    }
+}
+
+MappedIOSystem::MappedIOStream::MappedIOStream(std::unique_ptr<QFile> file, const uchar* data, size_t size):
+    file(std::move(file)), data(data), size(size), offset(0) {
+
+}
+
+size_t MappedIOSystem::MappedIOStream::Read(void* buffer, size_t size, size_t count) {
+    if (size == 0 || count == 0) return 0;
+    size_t available = (this->size - this->offset) / size;
+    size_t readCount = count < available ? count : available;
+    memcpy(buffer, this->data + this->offset, readCount * size);
+    this->offset += readCount * size;
+    return readCount;
+}
+
+size_t MappedIOSystem::MappedIOStream::Write(const void* /*buffer*/, size_t /*size*/, size_t /*count*/) {
+    // streams are read-only mappings
+    return 0;
+}
+
+aiReturn MappedIOSystem::MappedIOStream::Seek(size_t offset, aiOrigin origin) {
+    size_t target;
+    switch (origin) {
+        case aiOrigin_SET:
+            target = offset;
+        break;
+        case aiOrigin_CUR:
+            target = this->offset + offset;
+        break;
+        case aiOrigin_END:
+            // Assimp passes the distance back from the end
+            if (offset > this->size) return aiReturn_FAILURE;
+            target = this->size - offset;
+        break;
+        default:
+            return aiReturn_FAILURE;
+    }
+    if (target > this->size) return aiReturn_FAILURE;
+    this->offset = target;
+    return aiReturn_SUCCESS;
+}
+
+size_t MappedIOSystem::MappedIOStream::Tell() const {
+    return this->offset;
+}
+
+size_t MappedIOSystem::MappedIOStream::FileSize() const {
+    return this->size;
+}
+
+void MappedIOSystem::MappedIOStream::Flush() {
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+
+#include <QFile>
+
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/DefaultIOSystem.h>
+
+// Assimp file access backed by read-only mappings, so importers read model files (and
+// whatever they reference, e.g. .mtl or .bin companions) straight out of the page
+// cache instead of through buffered stdio. Anything that can't be mapped, or is opened
+// for writing, goes to Assimp's default implementation.
+class MappedIOSystem: public Assimp::IOSystem {
+public:
+    MappedIOSystem();
+
+    bool Exists(const char* path) const override;
+    char getOsSeparator() const override;
+    Assimp::IOStream* Open(const char* path, const char* mode = "rb") override;
+    void Close(Assimp::IOStream* stream) override;
+
+private:
+    class MappedIOStream: public Assimp::IOStream {
+    public:
+        MappedIOStream(std::unique_ptr<QFile> file, const uchar* data, size_t size);
+
+        size_t Read(void* buffer, size_t size, size_t count) override;
+        size_t Write(const void* buffer, size_t size, size_t count) override;
+        aiReturn Seek(size_t offset, aiOrigin origin) override;
+        size_t Tell() const override;
+        size_t FileSize() const override;
+        void Flush() override;
+
+    private:
+        // unmapped when the file is destroyed
+        std::unique_ptr<QFile> file;
+        const uchar* data;
+        size_t size;
+        size_t offset;
+    };
+
+    Assimp::DefaultIOSystem fallback;
+};
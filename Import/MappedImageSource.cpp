@@ -0,0 +1,123 @@
+#include <cstring>
+#include <limits>
+#include <mutex>
+
+#include <QBuffer>
+#include <QFile>
+#include <QImage>
+#include <QImageReader>
+
+#include <IL/il.h>
+
+#include "MappedImageSource.h"
+#include "Util/DevILLock.h"
+#include "Util/StartupTimeline.h"
+
+namespace {
+    // Core's loaders share DevIL's origin mode and bound image, so both go back to how they were found
+    class ScopedDevILState {
+    public:
+        ScopedDevILState(): originSet(ilIsEnabled(IL_ORIGIN_SET)), originMode(ilGetInteger(IL_ORIGIN_MODE)), boundImage(ilGetInteger(IL_CUR_IMAGE)) {
+        }
+
+        ~ScopedDevILState() {
+            ilOriginFunc(this->originMode);
+            if (this->originSet) ilEnable(IL_ORIGIN_SET);
+            else ilDisable(IL_ORIGIN_SET);
+            ilBindImage(this->boundImage);
+        }
+
+    private:
+        ILboolean originSet;
+        ILint originMode;
+        ILint boundImage;
+    };
+}
+
+MappedImageSource::MappedImageSource() {
+
+}
+
+std::shared_ptr<Core::StandardImage> MappedImageSource::loadImageU(const std::string& path, Core::Bool reverseOrigin, Core::Bool premultiplyAlpha) {
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::ReadOnly)) return nullptr;
+    qint64 size = file.size();
+    if (size <= 0) return nullptr;
+    const uchar* data = file.map(0, size);
+    if (data == nullptr) return nullptr;
+    StartupTimeline::addBytesRead(size);
+
+    // Qt's readers are reentrant, so the common formats decode without waiting on the render
+    // thread's DevIL calls (Core::ModelLoader holds the lock for a whole model)
+    std::shared_ptr<Core::StandardImage> image = decodeWithQt(data, size, reverseOrigin);
+    if (!image) image = decodeWithDevIL(data, size, reverseOrigin);
+    if (!image) return nullptr;
+
+    Core::UInt32 width = image->getWidth();
+    Core::UInt32 height = image->getHeight();
+    Core::Byte* pixels = image->getImageData();
+    // Core::ImageLoader only decodes from a path and has no entry point for its conversion,
+    // so this matches its rounding rather than calling it
+    if (premultiplyAlpha) {
+        for (Core::UInt32 i = 0; i < width * height * 4; i += 4) {
+            Core::UInt32 alpha = pixels[i + 3];
+            pixels[i] = (Core::Byte)((pixels[i] * alpha + 127) / 255);
+            pixels[i + 1] = (Core::Byte)((pixels[i + 1] * alpha + 127) / 255);
+            pixels[i + 2] = (Core::Byte)((pixels[i + 2] * alpha + 127) / 255);
+        }
+    }
+    return image;
+}
+
+std::shared_ptr<Core::StandardImage> MappedImageSource::decodeWithQt(const uchar* data, qint64 size, Core::Bool reverseOrigin) {
+    if (size > std::numeric_limits<int>::max()) return nullptr;
+    QByteArray bytes = QByteArray::fromRawData(reinterpret_cast<const char*>(data), (int)size);
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::ReadOnly);
+    QImageReader reader(&buffer);
+    // formats without a Qt image plugin (or that it can't make sense of) are left to DevIL
+    if (!reader.canRead()) return nullptr;
+    QImage decoded = reader.read();
+    if (decoded.isNull()) return nullptr;
+    decoded = decoded.convertToFormat(QImage::Format_RGBA8888);
+    if (reverseOrigin) decoded = decoded.mirrored(false, true);
+
+    Core::UInt32 width = decoded.width();
+    Core::UInt32 height = decoded.height();
+    std::shared_ptr<Core::StandardImage> image = std::make_shared<Core::StandardImage>(width, height);
+    image->init();
+    Core::Byte* pixels = image->getImageData();
+    for (Core::UInt32 y = 0; y < height; y++) {
+        memcpy(pixels + y * width * 4, decoded.constScanLine(y), width * 4);
+    }
+    return image;
+}
+
+std::shared_ptr<Core::StandardImage> MappedImageSource::decodeWithDevIL(const uchar* data, qint64 size, Core::Bool reverseOrigin) {
+    DevILLock devILLock;
+    static std::once_flag ilInitialized;
+    std::call_once(ilInitialized, []() {
+        ilInit();
+    });
+    ScopedDevILState devILState;
+
+    ILuint imageName;
+    ilGenImages(1, &imageName);
+    ilBindImage(imageName);
+    ilEnable(IL_ORIGIN_SET);
+    ilOriginFunc(reverseOrigin ? IL_ORIGIN_LOWER_LEFT : IL_ORIGIN_UPPER_LEFT);
+
+    // DevIL sniffs the format from the header bytes
+    if (!ilLoadL(IL_TYPE_UNKNOWN, data, (ILuint)size) || !ilConvertImage(IL_RGBA, IL_UNSIGNED_BYTE)) {
+        ilDeleteImages(1, &imageName);
+        return nullptr;
+    }
+
+    Core::UInt32 width = ilGetInteger(IL_IMAGE_WIDTH);
+    Core::UInt32 height = ilGetInteger(IL_IMAGE_HEIGHT);
+    std::shared_ptr<Core::StandardImage> image = std::make_shared<Core::StandardImage>(width, height);
+    image->init();
+    memcpy(image->getImageData(), ilGetData(), width * height * 4);
+    ilDeleteImages(1, &imageName);
+    return image;
+}
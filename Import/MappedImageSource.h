@@ -0,0 +1,25 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <QtGlobal>
+
+#include "Core/image/StandardImage.h"
+
+// Decodes images straight out of a read-only mapping of the file instead of streaming it
+// through buffered reads. Qt's image readers handle whatever they have a plugin for, DevIL
+// the rest. Takes the same arguments as Core::ImageLoader::loadImageU. Takes the DevILLock
+// itself (only around the DevIL calls), so callers must not hold it.
+class MappedImageSource {
+public:
+    MappedImageSource();
+
+    // Returns nullptr if the file can't be mapped or decoded.
+    static std::shared_ptr<Core::StandardImage> loadImageU(const std::string& path, Core::Bool reverseOrigin, Core::Bool premultiplyAlpha);
+
+private:
+    // RGBA8, not premultiplied
+    static std::shared_ptr<Core::StandardImage> decodeWithQt(const uchar* data, qint64 size, Core::Bool reverseOrigin);
+    static std::shared_ptr<Core::StandardImage> decodeWithDevIL(const uchar* data, qint64 size, Core::Bool reverseOrigin);
+};
@@ -0,0 +1,381 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "MeshOptimizer.h"
+
+const Core::UInt32 MeshOptimizer::CacheSize = 16;
+const Core::UInt32 MeshOptimizer::OverdrawResolution = 256;
+std::atomic<Core::Bool> MeshOptimizer::overdrawMeasured(false);
+
+namespace {
+    // vertex -> the triangles using it, as ranges of one flat list
+    class Adjacency {
+    public:
+        Adjacency(const Core::UInt32* indices, Core::UInt32 triangleCount, Core::UInt32 vertexCount) {
+            this->offsets.assign(vertexCount + 1, 0);
+            for (Core::UInt32 i = 0; i < triangleCount * 3; i++) this->offsets[indices[i] + 1]++;
+            for (Core::UInt32 v = 0; v < vertexCount; v++) this->offsets[v + 1] += this->offsets[v];
+            this->triangles.resize(triangleCount * 3);
+            std::vector<Core::UInt32> fill(this->offsets.begin(), this->offsets.end() - 1);
+            for (Core::UInt32 t = 0; t < triangleCount; t++) {
+                for (Core::UInt32 c = 0; c < 3; c++) this->triangles[fill[indices[t * 3 + c]]++] = t;
+            }
+        }
+
+        std::vector<Core::UInt32> offsets;
+        std::vector<Core::UInt32> triangles;
+    };
+
+    class Cluster {
+    public:
+        Core::UInt32 begin;
+        Core::UInt32 end;
+        Core::Real sortKey;
+    };
+
+    // Tipsify: fans around one vertex at a time, moving on to a neighbour that will still be in
+    // the cache. A new cluster starts wherever the next fan begins with a cold cache.
+    void tipsify(const Core::UInt32* indices, Core::UInt32 triangleCount, Core::UInt32 vertexCount, Core::UInt32 cacheSize,
+                 std::vector<Core::UInt32>& order, std::vector<Core::UInt32>& clusterStarts) {
+        Adjacency adjacency(indices, triangleCount, vertexCount);
+        std::vector<Core::UInt32> live(vertexCount);
+        for (Core::UInt32 v = 0; v < vertexCount; v++) live[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+        std::vector<Core::UInt32> cacheTime(vertexCount, 0);
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<Core::UInt32> deadEnd;
+        std::vector<Core::UInt32> candidates;
+        Core::UInt32 time = cacheSize + 1;
+        Core::UInt32 cursor = 0;
+
+        order.clear();
+        order.reserve(triangleCount);
+        clusterStarts.clear();
+
+        Core::Int64 fanning = -1;
+        while (cursor < vertexCount && fanning < 0) {
+            if (live[cursor] > 0) fanning = cursor;
+            else cursor++;
+        }
+        if (fanning >= 0) clusterStarts.push_back(0);
+
+        while (fanning >= 0) {
+            candidates.clear();
+            for (Core::UInt32 k = adjacency.offsets[fanning]; k < adjacency.offsets[fanning + 1]; k++) {
+                Core::UInt32 t = adjacency.triangles[k];
+                if (emitted[t]) continue;
+                emitted[t] = true;
+                order.push_back(t);
+                for (Core::UInt32 c = 0; c < 3; c++) {
+                    Core::UInt32 v = indices[t * 3 + c];
+                    deadEnd.push_back(v);
+                    candidates.push_back(v);
+                    live[v]--;
+                    if (time - cacheTime[v] > cacheSize) cacheTime[v] = time++;
+                }
+            }
+
+            // prefer the oldest candidate that stays cached through all of its remaining triangles
+            Core::Int64 next = -1;
+            Core::Int64 bestPriority = -1;
+            for (Core::UInt32 v : candidates) {
+                if (live[v] == 0) continue;
+                Core::Int64 age = time - cacheTime[v];
+                Core::Int64 priority = age + 2 * (Core::Int64)live[v] <= (Core::Int64)cacheSize ? age : 0;
+                if (priority > bestPriority) {
+                    bestPriority = priority;
+                    next = v;
+                }
+            }
+            if (next < 0) {
+                while (next < 0 && !deadEnd.empty()) {
+                    Core::UInt32 v = deadEnd.back();
+                    deadEnd.pop_back();
+                    if (live[v] > 0) next = v;
+                }
+                while (next < 0 && cursor < vertexCount) {
+                    if (live[cursor] > 0) next = cursor;
+                    else cursor++;
+                }
+            }
+            if (next >= 0 && time - cacheTime[next] > cacheSize) clusterStarts.push_back(order.size());
+            fanning = next;
+        }
+    }
+
+    Core::Real edge(const Core::Real* a, const Core::Real* b, Core::Real x, Core::Real y) {
+        return (b[0] - a[0]) * (y - a[1]) - (b[1] - a[1]) * (x - a[0]);
+    }
+}
+
+void MeshOptimizer::Statistics::add(const Statistics& other) {
+    this->meshCount += other.meshCount;
+    this->shortIndexMeshCount += other.shortIndexMeshCount;
+    this->triangleCount += other.triangleCount;
+    this->vertexCount += other.vertexCount;
+    this->cacheMissesBefore += other.cacheMissesBefore;
+    this->cacheMissesAfter += other.cacheMissesAfter;
+    this->pixelsShadedBefore += other.pixelsShadedBefore;
+    this->pixelsShadedAfter += other.pixelsShadedAfter;
+    this->pixelsCovered += other.pixelsCovered;
+}
+
+Core::Real MeshOptimizer::Statistics::getACMRBefore() const {
+    return this->triangleCount > 0 ? (Core::Real)this->cacheMissesBefore / this->triangleCount : 0.0f;
+}
+
+Core::Real MeshOptimizer::Statistics::getACMRAfter() const {
+    return this->triangleCount > 0 ? (Core::Real)this->cacheMissesAfter / this->triangleCount : 0.0f;
+}
+
+Core::Real MeshOptimizer::Statistics::getOverdrawBefore() const {
+    return this->pixelsCovered > 0 ? (Core::Real)this->pixelsShadedBefore / this->pixelsCovered : 0.0f;
+}
+
+Core::Real MeshOptimizer::Statistics::getOverdrawAfter() const {
+    return this->pixelsCovered > 0 ? (Core::Real)this->pixelsShadedAfter / this->pixelsCovered : 0.0f;
+}
+
+void MeshOptimizer::setOverdrawMeasured(Core::Bool measured) {
+    overdrawMeasured = measured;
+}
+
+Core::Bool MeshOptimizer::isOverdrawMeasured() {
+    return overdrawMeasured;
+}
+
+void MeshOptimizer::optimize(MeshDescription& mesh, Core::Bool blended, Statistics& statistics) {
+    Statistics meshStatistics;
+    meshStatistics.meshCount = 1;
+    meshStatistics.triangleCount = mesh.indices.size() / 3;
+    if (meshStatistics.triangleCount == 0) {
+        statistics.add(meshStatistics);
+        return;
+    }
+
+    Core::Bool measured = overdrawMeasured;
+    meshStatistics.cacheMissesBefore = simulateCacheMisses(mesh.indices, mesh.vertexCount, CacheSize);
+    if (measured) measureOverdraw(mesh, meshStatistics.pixelsShadedBefore, meshStatistics.pixelsCovered);
+
+    reorderTriangles(mesh, !blended);
+    reorderVertices(mesh);
+
+    meshStatistics.vertexCount = mesh.vertexCount;
+    meshStatistics.shortIndexMeshCount = mesh.vertexCount <= 65536 ? 1 : 0;
+    meshStatistics.cacheMissesAfter = simulateCacheMisses(mesh.indices, mesh.vertexCount, CacheSize);
+    if (measured) {
+        Core::UInt64 pixelsCovered;
+        measureOverdraw(mesh, meshStatistics.pixelsShadedAfter, pixelsCovered);
+    }
+    statistics.add(meshStatistics);
+}
+
+Core::UInt64 MeshOptimizer::simulateCacheMisses(const DataArray<Core::UInt32>& indices, Core::UInt32 vertexCount, Core::UInt32 cacheSize) {
+    // a FIFO cache: a vertex is a hit while fewer than cacheSize misses have happened since its own
+    std::vector<Core::UInt32> timestamps(vertexCount, 0);
+    Core::UInt32 time = cacheSize + 1;
+    Core::UInt64 misses = 0;
+    for (size_t i = 0; i < indices.size(); i++) {
+        Core::UInt32 v = indices[i];
+        if (time - timestamps[v] > cacheSize) {
+            timestamps[v] = time++;
+            misses++;
+        }
+    }
+    return misses;
+}
+
+void MeshOptimizer::measureOverdraw(const MeshDescription& mesh, Core::UInt64& pixelsShaded, Core::UInt64& pixelsCovered) {
+    pixelsShaded = 0;
+    pixelsCovered = 0;
+    const Core::UInt32 triangleCount = mesh.indices.size() / 3;
+    if (triangleCount == 0 || mesh.vertexCount == 0) return;
+
+    const Core::Real* positions = mesh.positions.data();
+    Core::Real minimum[3], maximum[3];
+    for (Core::UInt32 a = 0; a < 3; a++) {
+        minimum[a] = std::numeric_limits<Core::Real>::max();
+        maximum[a] = -std::numeric_limits<Core::Real>::max();
+    }
+    for (Core::UInt32 v = 0; v < mesh.vertexCount; v++) {
+        for (Core::UInt32 a = 0; a < 3; a++) {
+            minimum[a] = std::min(minimum[a], positions[v * MeshDescription::PositionComponentCount + a]);
+            maximum[a] = std::max(maximum[a], positions[v * MeshDescription::PositionComponentCount + a]);
+        }
+    }
+    Core::Real extent = std::max(maximum[0] - minimum[0], std::max(maximum[1] - minimum[1], maximum[2] - minimum[2]));
+    if (!(extent > 0.0f)) return;
+
+    const Core::UInt32 resolution = OverdrawResolution;
+    const Core::Real scale = resolution / extent;
+    const Core::Real far = std::numeric_limits<Core::Real>::max();
+    std::vector<Core::Real> depth(resolution * resolution);
+    for (Core::UInt32 view = 0; view < 6; view++) {
+        const Core::UInt32 axis = view / 2;
+        const Core::Real direction = (view % 2) == 0 ? 1.0f : -1.0f;
+        const Core::UInt32 uAxis = (axis + 1) % 3;
+        const Core::UInt32 vAxis = (axis + 2) % 3;
+        std::fill(depth.begin(), depth.end(), far);
+
+        for (Core::UInt32 t = 0; t < triangleCount; t++) {
+            Core::Real p[3][3];
+            for (Core::UInt32 c = 0; c < 3; c++) {
+                const Core::Real* position = &positions[mesh.indices[t * 3 + c] * MeshDescription::PositionComponentCount];
+                p[c][0] = (position[uAxis] - minimum[uAxis]) * scale;
+                p[c][1] = (position[vAxis] - minimum[vAxis]) * scale;
+                p[c][2] = position[axis] * direction;
+            }
+            Core::Real area = edge(p[0], p[1], p[2][0], p[2][1]);
+            if (area == 0.0f) continue;
+            // nothing is culled, so both windings rasterize the same way
+            if (area < 0.0f) {
+                std::swap(p[1], p[2]);
+                area = -area;
+            }
+
+            Core::Int32 minX = std::max(0, (Core::Int32)std::floor(std::min(p[0][0], std::min(p[1][0], p[2][0]))));
+            Core::Int32 maxX = std::min((Core::Int32)resolution - 1, (Core::Int32)std::floor(std::max(p[0][0], std::max(p[1][0], p[2][0]))));
+            Core::Int32 minY = std::max(0, (Core::Int32)std::floor(std::min(p[0][1], std::min(p[1][1], p[2][1]))));
+            Core::Int32 maxY = std::min((Core::Int32)resolution - 1, (Core::Int32)std::floor(std::max(p[0][1], std::max(p[1][1], p[2][1]))));
+            for (Core::Int32 y = minY; y <= maxY; y++) {
+                Core::Real centerY = y + 0.5f;
+                for (Core::Int32 x = minX; x <= maxX; x++) {
+                    Core::Real centerX = x + 0.5f;
+                    Core::Real w0 = edge(p[1], p[2], centerX, centerY);
+                    Core::Real w1 = edge(p[2], p[0], centerX, centerY);
+                    Core::Real w2 = edge(p[0], p[1], centerX, centerY);
+                    if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) continue;
+                    Core::Real z = (w0 * p[0][2] + w1 * p[1][2] + w2 * p[2][2]) / area;
+                    Core::Real& stored = depth[y * resolution + x];
+                    if (z < stored) {
+                        stored = z;
+                        pixelsShaded++;
+                    }
+                }
+            }
+        }
+
+        for (Core::Real value : depth) {
+            if (value != far) pixelsCovered++;
+        }
+    }
+}
+
+void MeshOptimizer::reorderTriangles(MeshDescription& mesh, Core::Bool sortClusters) {
+    const Core::UInt32 triangleCount = mesh.indices.size() / 3;
+    const Core::UInt32* indices = mesh.indices.data();
+    std::vector<Core::UInt32> order;
+    std::vector<Core::UInt32> clusterStarts;
+    tipsify(indices, triangleCount, mesh.vertexCount, CacheSize, order, clusterStarts);
+
+    if (!sortClusters) {
+        std::vector<Core::UInt32> reordered;
+        reordered.reserve(triangleCount * 3);
+        for (Core::UInt32 t : order) {
+            for (Core::UInt32 c = 0; c < 3; c++) reordered.push_back(indices[t * 3 + c]);
+        }
+        mesh.indices.assign(std::move(reordered));
+        return;
+    }
+
+    // per-triangle centroid and area-weighted normal
+    const Core::Real* positions = mesh.positions.data();
+    std::vector<Core::Real> centroids(triangleCount * 3);
+    std::vector<Core::Real> normals(triangleCount * 3);
+    Core::Real meshCenter[3] = {0.0f, 0.0f, 0.0f};
+    Core::Real meshArea = 0.0f;
+    for (Core::UInt32 t = 0; t < triangleCount; t++) {
+        const Core::Real* a = &positions[indices[t * 3] * MeshDescription::PositionComponentCount];
+        const Core::Real* b = &positions[indices[t * 3 + 1] * MeshDescription::PositionComponentCount];
+        const Core::Real* c = &positions[indices[t * 3 + 2] * MeshDescription::PositionComponentCount];
+        Core::Real ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        Core::Real ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        Core::Real* n = &normals[t * 3];
+        n[0] = ab[1] * ac[2] - ab[2] * ac[1];
+        n[1] = ab[2] * ac[0] - ab[0] * ac[2];
+        n[2] = ab[0] * ac[1] - ab[1] * ac[0];
+        Core::Real area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        for (Core::UInt32 i = 0; i < 3; i++) {
+            centroids[t * 3 + i] = (a[i] + b[i] + c[i]) / 3.0f;
+            meshCenter[i] += centroids[t * 3 + i] * area;
+        }
+        meshArea += area;
+    }
+    if (meshArea > 0.0f) {
+        for (Core::UInt32 i = 0; i < 3; i++) meshCenter[i] /= meshArea;
+    }
+
+    // clusters that face away from the center, and sit far out along that direction, tend to
+    // occlude the rest of the mesh from any viewpoint, so they draw first
+    std::vector<Cluster> clusters(clusterStarts.size());
+    for (Core::UInt32 i = 0; i < clusters.size(); i++) {
+        Cluster& cluster = clusters[i];
+        cluster.begin = clusterStarts[i];
+        cluster.end = i + 1 < clusterStarts.size() ? clusterStarts[i + 1] : order.size();
+        Core::Real center[3] = {0.0f, 0.0f, 0.0f};
+        Core::Real normal[3] = {0.0f, 0.0f, 0.0f};
+        Core::Real area = 0.0f;
+        for (Core::UInt32 k = cluster.begin; k < cluster.end; k++) {
+            const Core::Real* n = &normals[order[k] * 3];
+            Core::Real triangleArea = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            for (Core::UInt32 j = 0; j < 3; j++) {
+                center[j] += centroids[order[k] * 3 + j] * triangleArea;
+                normal[j] += n[j];
+            }
+            area += triangleArea;
+        }
+        Core::Real normalLength = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        cluster.sortKey = 0.0f;
+        if (area > 0.0f && normalLength > 0.0f) {
+            for (Core::UInt32 j = 0; j < 3; j++) cluster.sortKey += (center[j] / area - meshCenter[j]) * normal[j] / normalLength;
+        }
+    }
+    std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b) {
+        return a.sortKey > b.sortKey;
+    });
+
+    std::vector<Core::UInt32> reordered;
+    reordered.reserve(triangleCount * 3);
+    for (const Cluster& cluster : clusters) {
+        for (Core::UInt32 k = cluster.begin; k < cluster.end; k++) {
+            for (Core::UInt32 c = 0; c < 3; c++) reordered.push_back(indices[order[k] * 3 + c]);
+        }
+    }
+    mesh.indices.assign(std::move(reordered));
+}
+
+void MeshOptimizer::reorderVertices(MeshDescription& mesh) {
+    const Core::UInt32 unused = std::numeric_limits<Core::UInt32>::max();
+    const Core::UInt32 oldVertexCount = mesh.vertexCount;
+    std::vector<Core::UInt32> oldToNew(oldVertexCount, unused);
+    std::vector<Core::UInt32> newToOld;
+    newToOld.reserve(oldVertexCount);
+    std::vector<Core::UInt32> indices(mesh.indices.data(), mesh.indices.data() + mesh.indices.size());
+    for (Core::UInt32& index : indices) {
+        if (oldToNew[index] == unused) {
+            oldToNew[index] = newToOld.size();
+            newToOld.push_back(index);
+        }
+        index = oldToNew[index];
+    }
+
+    remapArray(mesh.positions, oldVertexCount, newToOld);
+    remapArray(mesh.normals, oldVertexCount, newToOld);
+    remapArray(mesh.faceNormals, oldVertexCount, newToOld);
+    remapArray(mesh.tangents, oldVertexCount, newToOld);
+    remapArray(mesh.colors, oldVertexCount, newToOld);
+    remapArray(mesh.uvs, oldVertexCount, newToOld);
+    mesh.indices.assign(std::move(indices));
+    mesh.vertexCount = newToOld.size();
+}
+
+void MeshOptimizer::remapArray(DataArray<Core::Real>& array, Core::UInt32 vertexCount, const std::vector<Core::UInt32>& newToOld) {
+    if (array.size() == 0 || vertexCount == 0) return;
+    const size_t components = array.size() / vertexCount;
+    std::vector<Core::Real> remapped(newToOld.size() * components);
+    for (size_t v = 0; v < newToOld.size(); v++) {
+        std::copy(array.data() + newToOld[v] * components, array.data() + (newToOld[v] + 1) * components, remapped.data() + v * components);
+    }
+    array.assign(std::move(remapped));
+}
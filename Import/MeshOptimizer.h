@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "Core/common/types.h"
+
+#include "ModelDescription.h"
+
+// Import stage that reorders a mesh for the GPU without changing what it looks like:
+//
+//  - triangles are ordered with Tipsify (Sander, Nehab & Barczak 2007) for post-transform
+//    vertex cache hits, and the runs it produces between cache flushes are then sorted so
+//    outward-facing runs far from the mesh center draw first, which cuts overdraw. Blended
+//    meshes skip the sort: Tipsify keeps neighbouring triangles together, but sorting whole
+//    runs would visibly change which layers blend over which
+//  - vertices are renumbered in first-use order so vertex fetch walks memory forwards;
+//    vertices no triangle uses are dropped
+//
+// Statistics measure the vertex cache with a FIFO simulation (ACMR: transformed vertices
+// per triangle), before and after. Overdraw is measured only when asked for (--measure-overdraw,
+// on the baker or the editor), by rasterizing the mesh from the six axis directions without culling
+// (shaded / covered pixels); it costs more than the optimization itself.
+class MeshOptimizer {
+public:
+    static const Core::UInt32 CacheSize;
+    static const Core::UInt32 OverdrawResolution;
+
+    class Statistics {
+    public:
+        Core::UInt32 meshCount = 0;
+        // meshes with few enough vertices to be drawn with 16-bit indices
+        Core::UInt32 shortIndexMeshCount = 0;
+        Core::UInt64 triangleCount = 0;
+        Core::UInt64 vertexCount = 0;
+        Core::UInt64 cacheMissesBefore = 0;
+        Core::UInt64 cacheMissesAfter = 0;
+        Core::UInt64 pixelsShadedBefore = 0;
+        Core::UInt64 pixelsShadedAfter = 0;
+        Core::UInt64 pixelsCovered = 0;
+
+        void add(const Statistics& other);
+        Core::Real getACMRBefore() const;
+        Core::Real getACMRAfter() const;
+        Core::Real getOverdrawBefore() const;
+        Core::Real getOverdrawAfter() const;
+    };
+
+    // Reorders mesh in place; its arrays must be owned (fresh from ModelImporter).
+    static void optimize(MeshDescription& mesh, Core::Bool blended, Statistics& statistics);
+    // process-wide, off by default
+    static void setOverdrawMeasured(Core::Bool measured);
+    static Core::Bool isOverdrawMeasured();
+
+    static Core::UInt64 simulateCacheMisses(const DataArray<Core::UInt32>& indices, Core::UInt32 vertexCount, Core::UInt32 cacheSize);
+    static void measureOverdraw(const MeshDescription& mesh, Core::UInt64& pixelsShaded, Core::UInt64& pixelsCovered);
+
+private:
+    static void reorderTriangles(MeshDescription& mesh, Core::Bool sortClusters);
+    static void reorderVertices(MeshDescription& mesh);
+    static void remapArray(DataArray<Core::Real>& array, Core::UInt32 vertexCount, const std::vector<Core::UInt32>& newToOld);
+
+    static std::atomic<Core::Bool> overdrawMeasured;
+};
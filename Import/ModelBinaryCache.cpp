@@ -0,0 +1,284 @@
+#include <cstring>
+#include <iostream>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include "ModelBinaryCache.h"
+#include "ModelCache.h"
+#include "Util/StartupTimeline.h"
+
+const Core::UInt32 ModelBinaryCache::Magic = 0x424C444D; // "MDLB"
+const Core::UInt32 ModelBinaryCache::Version = 1;
+const Core::UInt32 ModelBinaryCache::ArrayAlignment = 16;
+
+ModelBinaryCache::ModelBinaryCache() {
+
+}
+
+template <typename T>
+void ModelBinaryCache::writeValue(QByteArray& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void ModelBinaryCache::writeArray(QByteArray& out, const DataArray<T>& array) {
+    writeValue(out, (Core::UInt64)array.size());
+    Core::UInt32 misalignment = out.size() % ArrayAlignment;
+    if (misalignment != 0) out.append(ArrayAlignment - misalignment, '\0');
+    out.append(reinterpret_cast<const char*>(array.data()), sizeof(T) * array.size());
+}
+
+template <typename T>
+bool ModelBinaryCache::Reader::readArray(DataArray<T>& array) {
+    Core::UInt64 count;
+    if (!this->readValue(count)) return false;
+    Core::UInt64 misalignment = this->offset % ArrayAlignment;
+    if (misalignment != 0) this->offset += ArrayAlignment - misalignment;
+    if (this->offset > this->size || count > (this->size - this->offset) / sizeof(T)) return false;
+    // points into the mapped file, which the description's backingStore keeps alive
+    array.setExternal(reinterpret_cast<const T*>(this->data + this->offset), count);
+    this->offset += count * sizeof(T);
+    return true;
+}
+
+std::shared_ptr<ModelDescription> ModelBinaryCache::read(const ImportSettings& settings, bool verifySource) {
+    FileHeader expected;
+    if (verifySource && !getSourceStamp(settings.path, expected.sourceSize, expected.sourceModified)) return nullptr;
+
+    std::shared_ptr<QFile> file = std::make_shared<QFile>(QString::fromStdString(getCachePath(settings)));
+    if (!file->open(QIODevice::ReadOnly)) return nullptr;
+    const uchar* data = file->map(0, file->size());
+    if (data == nullptr) return nullptr;
+    StartupTimeline::addBytesRead(file->size());
+
+    if (verifySource) {
+        FileHeader header;
+        if (!Reader(data, file->size()).readValue(header)) return nullptr;
+        if (header.sourceSize != expected.sourceSize || header.sourceModified != expected.sourceModified) return nullptr;
+    }
+    return deserialize(data, file->size(), settings, file);
+}
+
+std::shared_ptr<ModelDescription> ModelBinaryCache::deserialize(const uchar* data, Core::UInt64 size, const ImportSettings& settings,
+                                                                std::shared_ptr<void> backingStore) {
+    Reader reader(data, size);
+    FileHeader header;
+    if (!reader.readValue(header)) return nullptr;
+    if (header.magic != Magic || header.version != Version) return nullptr;
+
+    std::string key;
+    if (!reader.readString(key) || key != ModelCache::getKey(settings)) return nullptr;
+
+    std::shared_ptr<ModelDescription> description = std::make_shared<ModelDescription>();
+    description->settings = settings;
+    description->hasSkinnedMeshes = header.hasSkinnedMeshes != 0;
+    description->backingStore = backingStore;
+    // skinned models are only recorded as such, Core::ModelLoader reads them from the source
+    if (description->hasSkinnedMeshes) return description;
+
+    // every record takes at least a length prefix, so counts the rest of the file can't hold are corrupt
+    // (and mustn't be used to size the vectors below)
+    Core::UInt64 recordCount = (Core::UInt64)header.imageCount + header.materialCount + header.meshCount + header.nodeCount;
+    if (recordCount * sizeof(Core::UInt32) > reader.getRemaining()) return nullptr;
+
+    // images are stored by path, their compressed blocks live in CompressedTextureCache
+    description->images.resize(header.imageCount);
+    for (ImageDescription& image : description->images) {
+        if (!reader.readString(image.path)) return nullptr;
+    }
+
+    description->materials.resize(header.materialCount);
+    for (MaterialDescription& material : description->materials) {
+        Core::Real color[4];
+        if (!reader.readString(material.name) || !reader.readRaw(color, sizeof(color)) ||
+            !reader.readValue(material.opacity) || !reader.readValue(material.albedoImage) || !reader.readValue(material.normalImage)) return nullptr;
+        material.diffuseColor.set(color[0], color[1], color[2], color[3]);
+        if (material.albedoImage < -1 || material.albedoImage >= (Core::Int32)header.imageCount ||
+            material.normalImage < -1 || material.normalImage >= (Core::Int32)header.imageCount) return nullptr;
+    }
+
+    description->meshes.resize(header.meshCount);
+    for (MeshDescription& mesh : description->meshes) {
+        if (!reader.readString(mesh.name) || !reader.readValue(mesh.vertexCount) || !reader.readValue(mesh.materialIndex)) return nullptr;
+        if (!reader.readArray(mesh.positions) || !reader.readArray(mesh.normals) || !reader.readArray(mesh.faceNormals) ||
+            !reader.readArray(mesh.tangents) || !reader.readArray(mesh.colors) || !reader.readArray(mesh.uvs) || !reader.readArray(mesh.indices)) return nullptr;
+        if (!validateMesh(mesh, header.materialCount)) return nullptr;
+    }
+
+    description->nodes.resize(header.nodeCount);
+    for (NodeDescription& node : description->nodes) {
+        Core::UInt32 meshCount, childCount;
+        if (!reader.readString(node.name) || !reader.readRaw(node.localTransform.getData(), sizeof(Core::Real) * 16)) return nullptr;
+        if (!reader.readValue(meshCount) || meshCount > reader.getRemaining() / sizeof(Core::UInt32)) return nullptr;
+        node.meshes.resize(meshCount);
+        if (!reader.readRaw(node.meshes.data(), sizeof(Core::UInt32) * meshCount)) return nullptr;
+        if (!reader.readValue(childCount) || childCount > reader.getRemaining() / sizeof(Core::UInt32)) return nullptr;
+        node.children.resize(childCount);
+        if (!reader.readRaw(node.children.data(), sizeof(Core::UInt32) * childCount)) return nullptr;
+    }
+
+    if (!validateNodes(*description)) return nullptr;
+    return description;
+}
+
+bool ModelBinaryCache::validateMesh(const MeshDescription& mesh, Core::UInt32 materialCount) {
+    if (mesh.materialIndex >= materialCount) return false;
+
+    Core::UInt64 vertexCount = mesh.vertexCount;
+    if (mesh.positions.size() != vertexCount * MeshDescription::PositionComponentCount) return false;
+    // the optional attributes are either missing or cover every vertex; ModelBuilder stores
+    // face normals whenever there are normals
+    Core::Bool hasNormals = mesh.normals.size() > 0;
+    if (hasNormals && (mesh.normals.size() != vertexCount * MeshDescription::NormalComponentCount ||
+                       mesh.faceNormals.size() != vertexCount * MeshDescription::NormalComponentCount)) return false;
+    if (!hasNormals && mesh.faceNormals.size() > 0) return false;
+    if (mesh.tangents.size() > 0 && mesh.tangents.size() != vertexCount * MeshDescription::NormalComponentCount) return false;
+    if (mesh.colors.size() > 0 && mesh.colors.size() != vertexCount * MeshDescription::ColorComponentCount) return false;
+    if (mesh.uvs.size() > 0 && mesh.uvs.size() != vertexCount * MeshDescription::UVComponentCount) return false;
+
+    if (mesh.indices.size() % 3 != 0) return false;
+    const Core::UInt32* indices = mesh.indices.data();
+    for (size_t i = 0; i < mesh.indices.size(); i++) {
+        if (indices[i] >= mesh.vertexCount) return false;
+    }
+    return true;
+}
+
+bool ModelBinaryCache::validateNodes(const ModelDescription& description) {
+    if (description.nodes.size() == 0) return false;
+
+    // walk from the root: every node has to be reached exactly once, which rules out
+    // cycles, shared children and out of range indices in one pass
+    std::vector<Core::Bool> visited(description.nodes.size(), false);
+    std::vector<Core::UInt32> pending = {0};
+    visited[0] = true;
+    size_t visitedCount = 1;
+    while (pending.size() > 0) {
+        const NodeDescription& node = description.nodes[pending.back()];
+        pending.pop_back();
+        for (Core::UInt32 meshIndex : node.meshes) {
+            if (meshIndex >= description.meshes.size()) return false;
+        }
+        for (Core::UInt32 childIndex : node.children) {
+            if (childIndex >= description.nodes.size() || visited[childIndex]) return false;
+            visited[childIndex] = true;
+            visitedCount++;
+            pending.push_back(childIndex);
+        }
+    }
+    return visitedCount == description.nodes.size();
+}
+
+bool ModelBinaryCache::write(const ModelDescription& description) {
+    QByteArray out;
+    if (!serialize(description, out)) return false;
+
+    QString cachePath = QString::fromStdString(getCachePath(description.settings));
+    QDir().mkpath(QFileInfo(cachePath).absolutePath());
+    // QSaveFile writes to a temporary and renames, so readers never see a partial file
+    QSaveFile file(cachePath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(out) != out.size() || !file.commit()) {
+        std::cout << "ModelBinaryCache::write() -> Unable to write '" << cachePath.toStdString() << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ModelBinaryCache::serialize(const ModelDescription& description, QByteArray& out) {
+    FileHeader header;
+    header.magic = Magic;
+    header.version = Version;
+    if (!getSourceStamp(description.settings.path, header.sourceSize, header.sourceModified)) return false;
+    header.hasSkinnedMeshes = description.hasSkinnedMeshes ? 1 : 0;
+    header.imageCount = description.images.size();
+    header.materialCount = description.materials.size();
+    header.meshCount = description.meshes.size();
+    header.nodeCount = description.nodes.size();
+    header.reserved = 0;
+
+    out.clear();
+    writeValue(out, header);
+    writeString(out, ModelCache::getKey(description.settings));
+
+    for (const ImageDescription& image : description.images) {
+        writeString(out, image.path);
+    }
+
+    for (const MaterialDescription& material : description.materials) {
+        Core::Real color[4] = {material.diffuseColor.r, material.diffuseColor.g, material.diffuseColor.b, material.diffuseColor.a};
+        writeString(out, material.name);
+        out.append(reinterpret_cast<const char*>(color), sizeof(color));
+        writeValue(out, material.opacity);
+        writeValue(out, material.albedoImage);
+        writeValue(out, material.normalImage);
+    }
+
+    for (const MeshDescription& mesh : description.meshes) {
+        writeString(out, mesh.name);
+        writeValue(out, mesh.vertexCount);
+        writeValue(out, mesh.materialIndex);
+        writeArray(out, mesh.positions);
+        writeArray(out, mesh.normals);
+        writeArray(out, mesh.faceNormals);
+        writeArray(out, mesh.tangents);
+        writeArray(out, mesh.colors);
+        writeArray(out, mesh.uvs);
+        writeArray(out, mesh.indices);
+    }
+
+    for (const NodeDescription& node : description.nodes) {
+        writeString(out, node.name);
+        Core::Matrix4x4 localTransform;
+        localTransform.copy(node.localTransform);
+        out.append(reinterpret_cast<const char*>(localTransform.getData()), sizeof(Core::Real) * 16);
+        writeValue(out, (Core::UInt32)node.meshes.size());
+        out.append(reinterpret_cast<const char*>(node.meshes.data()), sizeof(Core::UInt32) * node.meshes.size());
+        writeValue(out, (Core::UInt32)node.children.size());
+        out.append(reinterpret_cast<const char*>(node.children.data()), sizeof(Core::UInt32) * node.children.size());
+    }
+    return true;
+}
+
+std::string ModelBinaryCache::getCachePath(const ImportSettings& settings) {
+    QByteArray hash = QCryptographicHash::hash(QByteArray::fromStdString(ModelCache::getKey(settings)), QCryptographicHash::Sha1).toHex();
+    QString directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/models/";
+    return (directory + QString::fromLatin1(hash) + ".mdlb").toStdString();
+}
+
+bool ModelBinaryCache::getSourceStamp(const std::string& path, Core::UInt64& size, Core::Int64& modified) {
+    QFileInfo sourceInfo(QString::fromStdString(path));
+    if (!sourceInfo.exists()) return false;
+    size = sourceInfo.size();
+    modified = sourceInfo.lastModified().toMSecsSinceEpoch();
+    return true;
+}
+
+void ModelBinaryCache::writeString(QByteArray& out, const std::string& value) {
+    writeValue(out, (Core::UInt32)value.size());
+    out.append(value.data(), value.size());
+}
+
+ModelBinaryCache::Reader::Reader(const uchar* data, Core::UInt64 size): data(data), size(size), offset(0) {
+
+}
+
+bool ModelBinaryCache::Reader::readRaw(void* dest, Core::UInt64 byteCount) {
+    if (byteCount > this->size - this->offset) return false;
+    if (byteCount > 0) memcpy(dest, this->data + this->offset, byteCount);
+    this->offset += byteCount;
+    return true;
+}
+
+bool ModelBinaryCache::Reader::readString(std::string& value) {
+    Core::UInt32 length;
+    if (!this->readValue(length) || length > this->size - this->offset) return false;
+    value.assign(reinterpret_cast<const char*>(this->data + this->offset), length);
+    this->offset += length;
+    return true;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <QByteArray>
+
+#include "ModelDescription.h"
+
+// Baked, post-import copy of a ModelDescription on disk. Warm loads map the file and
+// point mesh arrays straight into it, so no Assimp parse or normal smoothing is needed.
+//
+// Layout (native byte order): a FileHeader, the settings key, then images, materials,
+// meshes and nodes as length-prefixed records. Vertex and index arrays start on
+// ArrayAlignment boundaries relative to the start of the file.
+class ModelBinaryCache {
+public:
+    static const Core::UInt32 Magic;
+    static const Core::UInt32 Version;
+    static const Core::UInt32 ArrayAlignment;
+
+    ModelBinaryCache();
+
+    // Returns nullptr if there is no entry, or it is stale, corrupt or from another version.
+    // Every count and index in the file is checked against the arrays it refers to, so a
+    // truncated or tampered file never reaches ModelBuilder.
+    // Callers that have already verified the sources' content (AssetDependencyGraph) can
+    // skip the size/modification time comparison with verifySource = false.
+    static std::shared_ptr<ModelDescription> read(const ImportSettings& settings, bool verifySource = true);
+    static bool write(const ModelDescription& description);
+
+    // The same layout in memory, for handing a description across a process boundary
+    // (see ImportWorkerPool). deserialize() points the mesh arrays into data, which
+    // backingStore must keep alive; data needs ArrayAlignment alignment.
+    static bool serialize(const ModelDescription& description, QByteArray& out);
+    static std::shared_ptr<ModelDescription> deserialize(const uchar* data, Core::UInt64 size, const ImportSettings& settings,
+                                                         std::shared_ptr<void> backingStore);
+
+    static std::string getCachePath(const ImportSettings& settings);
+
+private:
+    class FileHeader {
+    public:
+        Core::UInt32 magic;
+        Core::UInt32 version;
+        Core::UInt64 sourceSize;
+        Core::Int64 sourceModified;
+        Core::UInt32 hasSkinnedMeshes;
+        Core::UInt32 imageCount;
+        Core::UInt32 materialCount;
+        Core::UInt32 meshCount;
+        Core::UInt32 nodeCount;
+        Core::UInt32 reserved;
+    };
+
+    class Reader {
+    public:
+        Reader(const uchar* data, Core::UInt64 size);
+        bool readRaw(void* dest, Core::UInt64 byteCount);
+        template <typename T> bool readValue(T& value) { return this->readRaw(&value, sizeof(T)); }
+        bool readString(std::string& value);
+        template <typename T> bool readArray(DataArray<T>& array);
+        Core::UInt64 getRemaining() const { return this->size - this->offset; }
+
+    private:
+        const uchar* data;
+        Core::UInt64 size;
+        Core::UInt64 offset;
+    };
+
+    static bool validateMesh(const MeshDescription& mesh, Core::UInt32 materialCount);
+    static bool validateNodes(const ModelDescription& description);
+
+    static void writeString(QByteArray& out, const std::string& value);
+    template <typename T> static void writeValue(QByteArray& out, const T& value);
+    template <typename T> static void writeArray(QByteArray& out, const DataArray<T>& array);
+
+    static bool getSourceStamp(const std::string& path, Core::UInt64& size, Core::Int64& modified);
+};
@@ -0,0 +1,210 @@
+#include <sstream>
+#include <unordered_map>
+
+#include "ModelBuilder.h"
+
+#include "Core/animation/KeyFrameSet.h"
+#include "Core/animation/TranslationKeyFrame.h"
+#include "Core/animation/RotationKeyFrame.h"
+#include "Core/animation/ScaleKeyFrame.h"
+#include "Core/image/TextureAttr.h"
+#include "Core/math/Quaternion.h"
+#include "Core/math/Vector3.h"
+#include "Core/material/StandardAttributes.h"
+#include "Core/material/StandardPhysicalMaterial.h"
+#include "Core/render/MeshRenderer.h"
+#include "Core/render/RenderableContainer.h"
+
+ModelBuilder::ModelBuilder() {
+
+}
+
+std::shared_ptr<ModelResources> ModelBuilder::buildResources(Core::WeakPointer<Core::Engine> engine, std::shared_ptr<ModelDescription> model,
+                                                             LazyTextureLoader& textureLoader, GeometryRegistry& geometry) {
+    const ModelDescription& description = *model;
+    std::shared_ptr<ModelResources> resources = std::make_shared<ModelResources>();
+    // normal maps need a placeholder that doesn't bend the surface normal while they load
+    std::vector<Core::Bool> isNormalMap(description.images.size(), false);
+    for (const MaterialDescription& materialDescription : description.materials) {
+        if (materialDescription.normalImage >= 0) isNormalMap[materialDescription.normalImage] = true;
+    }
+    for (Core::UInt32 i = 0; i < description.images.size(); i++) {
+        LazyTextureLoader::Placeholder placeholder = isNormalMap[i] ? LazyTextureLoader::Placeholder::FlatNormal : LazyTextureLoader::Placeholder::White;
+        resources->textures.push_back(buildTexture(engine, description.images[i], textureLoader, placeholder));
+    }
+
+    // exporters often emit one material per mesh even when they're identical, those share one prototype
+    std::unordered_map<std::string, Core::WeakPointer<Core::Material>> prototypes;
+    for (const MaterialDescription& materialDescription : description.materials) {
+        std::ostringstream ss;
+        const Core::Color& color = materialDescription.diffuseColor;
+        ss << materialDescription.albedoImage << "|" << materialDescription.normalImage << "|" << color.r << "|" << color.g << "|"
+           << color.b << "|" << color.a << "|" << materialDescription.opacity;
+        Core::WeakPointer<Core::Material>& prototype = prototypes[ss.str()];
+        if (!prototype.isValid()) prototype = buildMaterial(engine, materialDescription, resources->textures);
+        resources->materials.push_back(prototype);
+    }
+
+    for (Core::UInt32 i = 0; i < description.meshes.size(); i++) {
+        const MeshDescription& meshDescription = description.meshes[i];
+        Core::Real smoothingThreshold = description.settings.smoothingThreshold;
+        resources->meshes.push_back(geometry.resolve(meshDescription, smoothingThreshold, [engine, &meshDescription, smoothingThreshold]() {
+            return buildMesh(engine, meshDescription, smoothingThreshold);
+        }));
+    }
+    return resources;
+}
+
+Core::WeakPointer<Core::Object3D> ModelBuilder::instantiate(Core::WeakPointer<Core::Engine> engine, const ModelDescription& description,
+                                                            const ModelResources& resources, Core::Bool castShadows) {
+    // callers tweak materials per instance (metallic, blending, culling...), so each instance gets its own copies
+    std::vector<Core::WeakPointer<Core::Material>> materials;
+    std::unordered_map<Core::UInt64, Core::WeakPointer<Core::Material>> clones;
+    for (Core::WeakPointer<Core::Material> prototype : resources.materials) {
+        Core::WeakPointer<Core::Material>& clone = clones[prototype->getObjectID()];
+        if (!clone.isValid()) clone = prototype->clone();
+        materials.push_back(clone);
+    }
+    return buildNode(engine, description, 0, resources.meshes, materials, castShadows);
+}
+
+Core::WeakPointer<Core::Animation> ModelBuilder::buildAnimation(Core::WeakPointer<Core::Engine> engine, const AnimationDescription& description) {
+    Core::WeakPointer<Core::Animation> animation = engine->createAnimation(description.durationTicks, description.ticksPerSecond);
+    if (!animation->init(description.channels.size())) {
+        Core::Engine::safeReleaseObject(animation);
+        return Core::WeakPointer<Core::Animation>();
+    }
+
+    // Core keys carry their time three ways: normalized, seconds and ticks
+    Core::Real duration = description.durationTicks > 0.0f ? description.durationTicks : 1.0f;
+    for (Core::UInt32 c = 0; c < description.channels.size(); c++) {
+        const AnimationChannelDescription& channel = description.channels[c];
+        animation->setChannelMapping(channel.nodeName, c);
+        Core::KeyFrameSet* keyFrameSet = animation->getKeyFrameSet(c);
+        keyFrameSet->used = true;
+        for (const VectorKeyDescription& key : channel.translations) {
+            keyFrameSet->translationKeyFrameSequence.push_back(Core::TranslationKeyFrame(key.time / duration, key.time / description.ticksPerSecond, key.time,
+                                                                                         Core::Vector3r(key.value[0], key.value[1], key.value[2])));
+        }
+        for (const RotationKeyDescription& key : channel.rotations) {
+            keyFrameSet->rotationKeyFrameSequence.push_back(Core::RotationKeyFrame(key.time / duration, key.time / description.ticksPerSecond, key.time,
+                                                                                   Core::Quaternion(key.value[0], key.value[1], key.value[2], key.value[3])));
+        }
+        for (const VectorKeyDescription& key : channel.scales) {
+            keyFrameSet->scaleKeyFrameSequence.push_back(Core::ScaleKeyFrame(key.time / duration, key.time / description.ticksPerSecond, key.time,
+                                                                             Core::Vector3r(key.value[0], key.value[1], key.value[2])));
+        }
+    }
+    return animation;
+}
+
+Core::WeakPointer<Core::Mesh> ModelBuilder::buildMesh(Core::WeakPointer<Core::Engine> engine, const MeshDescription& meshDescription, Core::Real smoothingThreshold) {
+    Core::WeakPointer<Core::Mesh> mesh = engine->createMesh(meshDescription.vertexCount, meshDescription.indices.size());
+    mesh->init();
+
+    mesh->enableAttribute(Core::StandardAttribute::Position);
+    mesh->initVertexPositions();
+    mesh->getVertexPositions()->store(meshDescription.positions.data());
+
+    mesh->enableAttribute(Core::StandardAttribute::Normal);
+    mesh->initVertexNormals();
+    mesh->enableAttribute(Core::StandardAttribute::FaceNormal);
+    mesh->initVertexFaceNormals();
+    Core::Bool hasNormals = meshDescription.normals.size() > 0;
+    if (hasNormals) {
+        mesh->getVertexNormals()->store(meshDescription.normals.data());
+        mesh->getVertexFaceNormals()->store(meshDescription.faceNormals.data());
+    }
+
+    if (meshDescription.tangents.size() > 0) {
+        mesh->enableAttribute(Core::StandardAttribute::Tangent);
+        mesh->initVertexTangents();
+        mesh->getVertexTangents()->store(meshDescription.tangents.data());
+    }
+
+    if (meshDescription.colors.size() > 0) {
+        mesh->enableAttribute(Core::StandardAttribute::Color);
+        mesh->initVertexColors();
+        mesh->getVertexColors()->store(meshDescription.colors.data());
+    }
+
+    if (meshDescription.uvs.size() > 0) {
+        mesh->enableAttribute(Core::StandardAttribute::AlbedoUV);
+        mesh->initVertexAlbedoUVs();
+        mesh->getVertexAlbedoUVs()->store(meshDescription.uvs.data());
+        mesh->enableAttribute(Core::StandardAttribute::NormalUV);
+        mesh->initVertexNormalUVs();
+        mesh->getVertexNormalUVs()->store(meshDescription.uvs.data());
+    }
+
+    mesh->getIndexBuffer()->setIndices(meshDescription.indices.data());
+    mesh->calculateBoundingBox();
+    if (!hasNormals) mesh->calculateNormals(smoothingThreshold);
+    return mesh;
+}
+
+Core::WeakPointer<Core::Texture2D> ModelBuilder::buildTexture(Core::WeakPointer<Core::Engine> engine, const ImageDescription& imageDescription,
+                                                               LazyTextureLoader& textureLoader, LazyTextureLoader::Placeholder placeholder) {
+    Core::TextureAttributes textureAttributes;
+    textureAttributes.FilterMode = Core::TextureFilter::TriLinear;
+    textureAttributes.MipLevels = 4;
+    textureAttributes.WrapMode = Core::TextureWrap::Repeat;
+    textureAttributes.Format = Core::TextureFormat::RGBA8;
+    return textureLoader.load(engine, imageDescription.path, textureAttributes, placeholder);
+}
+
+Core::WeakPointer<Core::Material> ModelBuilder::buildMaterial(Core::WeakPointer<Core::Engine> engine, const MaterialDescription& materialDescription,
+                                                              const std::vector<Core::WeakPointer<Core::Texture2D>>& textures) {
+    Core::WeakPointer<Core::StandardPhysicalMaterial> material = engine->createMaterial<Core::StandardPhysicalMaterial>();
+    material->setLit(true);
+    // the exporter's opacity only shows on meshes that get a blending mode (see SceneHelper::configureStandardMaterial)
+    Core::Color albedo = materialDescription.diffuseColor;
+    albedo.a *= materialDescription.opacity;
+    material->setAlbedo(albedo);
+    if (materialDescription.albedoImage >= 0) {
+        material->setAlbedoMap(textures[materialDescription.albedoImage]);
+        material->setAlbedoMapEnabled(true);
+    }
+    if (materialDescription.normalImage >= 0) {
+        material->setNormalMap(textures[materialDescription.normalImage]);
+        material->setNormalMapEnabled(true);
+    }
+    return material;
+}
+
+Core::WeakPointer<Core::Object3D> ModelBuilder::buildNode(Core::WeakPointer<Core::Engine> engine, const ModelDescription& description, Core::UInt32 nodeIndex,
+                                                          const std::vector<Core::WeakPointer<Core::Mesh>>& meshes,
+                                                          const std::vector<Core::WeakPointer<Core::Material>>& materials, Core::Bool castShadows) {
+    const NodeDescription& node = description.nodes[nodeIndex];
+    Core::WeakPointer<Core::Object3D> object = engine->createObject3D();
+    object->setName(node.name);
+    object->getTransform().getLocalMatrix().copy(node.localTransform);
+
+    // A single mesh lives directly on the node so lookups by node name keep working,
+    // multiple meshes each get their own child since a renderer has one material.
+    if (node.meshes.size() == 1) {
+        Core::UInt32 meshIndex = node.meshes[0];
+        attachMesh(engine, object, meshes[meshIndex], materials[description.meshes[meshIndex].materialIndex], castShadows);
+    }
+    else {
+        for (Core::UInt32 meshIndex : node.meshes) {
+            Core::WeakPointer<Core::Object3D> meshObject = engine->createObject3D();
+            meshObject->setName(node.name);
+            object->addChild(meshObject);
+            attachMesh(engine, meshObject, meshes[meshIndex], materials[description.meshes[meshIndex].materialIndex], castShadows);
+        }
+    }
+
+    for (Core::UInt32 childIndex : node.children) {
+        object->addChild(buildNode(engine, description, childIndex, meshes, materials, castShadows));
+    }
+    return object;
+}
+
+void ModelBuilder::attachMesh(Core::WeakPointer<Core::Engine> engine, Core::WeakPointer<Core::Object3D> object, Core::WeakPointer<Core::Mesh> mesh,
+                              Core::WeakPointer<Core::Material> material, Core::Bool castShadows) {
+    Core::WeakPointer<Core::MeshRenderer> meshRenderer = engine->createRenderer<Core::MeshRenderer, Core::Mesh>(material, object);
+    meshRenderer->setCastShadows(castShadows);
+    Core::WeakPointer<Core::MeshContainer> meshContainer = engine->createRenderableContainer<Core::MeshContainer, Core::Mesh>(object);
+    meshContainer->addRenderable(mesh);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Core/Engine.h"
+#include "Core/scene/Object3D.h"
+#include "Core/geometry/Mesh.h"
+#include "Core/image/Texture2D.h"
+#include "Core/material/Material.h"
+#include "Core/animation/Animation.h"
+
+#include "ModelDescription.h"
+#include "LazyTextureLoader.h"
+#include "GeometryRegistry.h"
+
+// GPU resources built once per imported model. Meshes and textures are shared by all
+// instances, materials are prototypes that get cloned for each instance.
+class ModelResources {
+public:
+    std::vector<Core::WeakPointer<Core::Texture2D>> textures;
+    std::vector<Core::WeakPointer<Core::Material>> materials;
+    std::vector<Core::WeakPointer<Core::Mesh>> meshes;
+};
+
+// Render-thread half of the import pipeline: creates the GPU resources and the
+// Object3D hierarchy for a ModelDescription produced by ModelImporter.
+class ModelBuilder {
+public:
+    ModelBuilder();
+    // Textures come back as placeholders that textureLoader fills in over the following frames.
+    // Meshes identical to one geometry has already built reuse it instead of being uploaded again.
+    static std::shared_ptr<ModelResources> buildResources(Core::WeakPointer<Core::Engine> engine, std::shared_ptr<ModelDescription> description,
+                                                          LazyTextureLoader& textureLoader, GeometryRegistry& geometry);
+    static Core::WeakPointer<Core::Object3D> instantiate(Core::WeakPointer<Core::Engine> engine, const ModelDescription& description,
+                                                         const ModelResources& resources, Core::Bool castShadows);
+    // Channels are mapped by node name, so the clip plays on any skeleton with matching nodes.
+    static Core::WeakPointer<Core::Animation> buildAnimation(Core::WeakPointer<Core::Engine> engine, const AnimationDescription& description);
+
+private:
+    static Core::WeakPointer<Core::Mesh> buildMesh(Core::WeakPointer<Core::Engine> engine, const MeshDescription& meshDescription, Core::Real smoothingThreshold);
+    static Core::WeakPointer<Core::Texture2D> buildTexture(Core::WeakPointer<Core::Engine> engine, const ImageDescription& imageDescription,
+                                                           LazyTextureLoader& textureLoader, LazyTextureLoader::Placeholder placeholder);
+    static Core::WeakPointer<Core::Material> buildMaterial(Core::WeakPointer<Core::Engine> engine, const MaterialDescription& materialDescription,
+                                                           const std::vector<Core::WeakPointer<Core::Texture2D>>& textures);
+    static Core::WeakPointer<Core::Object3D> buildNode(Core::WeakPointer<Core::Engine> engine, const ModelDescription& description, Core::UInt32 nodeIndex,
+                                                       const std::vector<Core::WeakPointer<Core::Mesh>>& meshes,
+                                                       const std::vector<Core::WeakPointer<Core::Material>>& materials, Core::Bool castShadows);
+    static void attachMesh(Core::WeakPointer<Core::Engine> engine, Core::WeakPointer<Core::Object3D> object, Core::WeakPointer<Core::Mesh> mesh,
+                           Core::WeakPointer<Core::Material> material, Core::Bool castShadows);
+};
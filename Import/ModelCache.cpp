@@ -0,0 +1,194 @@
+#include <exception>
+#include <iostream>
+#include <sstream>
+
+#include <QFile>
+#include <QThreadPool>
+
+#include "ModelCache.h"
+#include "ModelImporter.h"
+#include "ModelBinaryCache.h"
+#include "ImportWorkerPool.h"
+#include "Exception.h"
+#include "Util/StartupTimeline.h"
+
+ModelCache::ModelCache() {
+
+}
+
+void ModelCache::load(const ImportSettings& settings, LoadCallback callback) {
+    std::string key = getKey(settings);
+    std::shared_ptr<ModelDescription> description;
+    {
+        QMutexLocker ml(&this->entriesMutex);
+        Entry& entry = this->entries[key];
+        if (!entry.description) {
+            entry.pendingCallbacks.push_back(callback);
+            // only the first request for a key starts a parse, later ones (and any during a rebuild) wait on it
+            if (!entry.parsing) {
+                entry.parsing = true;
+                QThreadPool::globalInstance()->start([this, key, settings]() {
+                    this->parse(key, settings);
+                });
+            }
+            return;
+        }
+        description = entry.description;
+    }
+    callback(description);
+}
+
+void ModelCache::parse(const std::string& key, const ImportSettings& settings) {
+    StartupTimeline::Scope timelineScope("ModelCache::parse " + settings.path);
+    // whatever goes wrong, the waiting callbacks still hear about it (with nullptr)
+    std::shared_ptr<ModelDescription> description;
+    try {
+        description = this->readOrImport(key, settings);
+        // hashed here so the render thread only has to compare the rare meshes that collide
+        // (skinned descriptions have no meshes, Core::ModelLoader builds them)
+        if (description) {
+            for (MeshDescription& mesh : description->meshes) {
+                mesh.contentHash = GeometryRegistry::hash(mesh, settings.smoothingThreshold);
+            }
+        }
+    }
+    catch (const Exception& ex) {
+        std::cout << "ModelCache::parse() -> '" << settings.path << "': " << ex.msg << std::endl;
+        description = nullptr;
+    }
+    catch (const std::exception& ex) {
+        std::cout << "ModelCache::parse() -> '" << settings.path << "': " << ex.what() << std::endl;
+        description = nullptr;
+    }
+    catch (...) {
+        std::cout << "ModelCache::parse() -> '" << settings.path << "': Unknown exception" << std::endl;
+        description = nullptr;
+    }
+
+    std::vector<LoadCallback> callbacks;
+    {
+        QMutexLocker ml(&this->entriesMutex);
+        Entry& entry = this->entries[key];
+        callbacks.swap(entry.pendingCallbacks);
+        // failed imports are forgotten so a later request can try again, and a rebuild nobody
+        // waited on only had to refresh the disk cache
+        if (description && callbacks.size() > 0) {
+            entry.description = description;
+            entry.parsing = false;
+        }
+        else {
+            this->entries.erase(key);
+        }
+    }
+    for (LoadCallback callback : callbacks) {
+        callback(description);
+    }
+}
+
+std::shared_ptr<ModelDescription> ModelCache::readOrImport(const std::string& key, const ImportSettings& settings) {
+    // a baked copy skips Assimp and normal smoothing entirely
+    std::shared_ptr<ModelDescription> description;
+    AssetDependencyGraph::State state = this->dependencies.check(key);
+    if (state == AssetDependencyGraph::State::Current) {
+        description = ModelBinaryCache::read(settings, false);
+    }
+    else if (state == AssetDependencyGraph::State::Stale) {
+        this->invalidate(key, settings);
+    }
+    else {
+        // baked before the graph knew about it (e.g. by the asset baker), fall back to the file's own stamp
+        description = ModelBinaryCache::read(settings);
+    }
+
+    if (!description) {
+        // out of process when a worker is available; it bakes the result to disk itself
+        description = ImportWorkerPool::import(settings);
+        if (!description) {
+            description = ModelImporter::importModel(settings);
+            ModelBinaryCache::write(*description);
+        }
+    }
+
+    if (state != AssetDependencyGraph::State::Current) {
+        std::vector<std::string> sources = {settings.path};
+        for (const ImageDescription& image : description->images) {
+            if (image.path.size() > 0) sources.push_back(image.path);
+        }
+        this->dependencies.record(settings, sources);
+        this->dependencies.save();
+    }
+    return description;
+}
+
+void ModelCache::invalidate(const std::string& key, const ImportSettings& settings) {
+    std::cout << "ModelCache::invalidate() -> Sources of '" << settings.path << "' changed, re-importing" << std::endl;
+    this->dependencies.remove(key);
+    QFile::remove(QString::fromStdString(ModelBinaryCache::getCachePath(settings)));
+}
+
+void ModelCache::rebuildStale() {
+    StartupTimeline::Scope timelineScope("ModelCache::rebuildStale");
+    this->dependencies.load();
+    for (const ImportSettings& settings : this->dependencies.getResults()) {
+        QThreadPool::globalInstance()->start([this, settings]() {
+            std::string key = getKey(settings);
+            if (this->dependencies.check(key) != AssetDependencyGraph::State::Stale) return;
+            {
+                QMutexLocker ml(&this->entriesMutex);
+                // a load() already in flight invalidates and re-imports it itself
+                if (this->entries.count(key) > 0) return;
+                // claimed, so a load() arriving meanwhile waits on this parse instead of starting its own
+                this->entries[key].parsing = true;
+            }
+            this->parse(key, settings);
+        });
+    }
+}
+
+std::shared_ptr<ModelResources> ModelCache::getResources(Core::WeakPointer<Core::Engine> engine, std::shared_ptr<ModelDescription> description,
+                                                         LazyTextureLoader& textureLoader) {
+    std::string key = getKey(description->settings);
+    {
+        QMutexLocker ml(&this->entriesMutex);
+        Entry& entry = this->entries[key];
+        if (entry.resources) return entry.resources;
+    }
+
+    // meshes released with an unloaded scene can't be shared any more
+    this->geometry.prune();
+    Core::UInt32 sharedBefore = this->geometry.getRequestCount() - this->geometry.getUniqueCount();
+    std::shared_ptr<ModelResources> resources = ModelBuilder::buildResources(engine, description, textureLoader, this->geometry);
+    for (Core::UInt32 i = 0; i < resources->meshes.size(); i++) {
+        Core::WeakPointer<Core::Material> prototype = resources->materials[description->meshes[i].materialIndex];
+        std::unordered_map<Core::UInt64, Core::WeakPointer<Core::Material>>::iterator itr = this->meshPrototypes.find(resources->meshes[i]->getObjectID());
+        if (itr == this->meshPrototypes.end()) {
+            this->meshPrototypes[resources->meshes[i]->getObjectID()] = prototype;
+        }
+        else if (!itr->second.isValid() || itr->second->getObjectID() != prototype->getObjectID()) {
+            // the same geometry wearing different materials, callers fall back to the instance's own material
+            itr->second = Core::WeakPointer<Core::Material>();
+        }
+    }
+    Core::UInt32 shared = this->geometry.getRequestCount() - this->geometry.getUniqueCount() - sharedBefore;
+    if (shared > 0) {
+        std::cout << "ModelCache::getResources() -> '" << description->settings.path << "': " << shared << " of " << resources->meshes.size()
+                  << " meshes reuse existing geometry; " << this->geometry.getUniqueCount() << " unique meshes, "
+                  << (this->geometry.getBytesSaved() / 1024) << " KB of geometry saved so far (uploads avoided less the copies kept to compare against)" << std::endl;
+    }
+    QMutexLocker ml(&this->entriesMutex);
+    this->entries[key].resources = resources;
+    return resources;
+}
+
+Core::WeakPointer<Core::Material> ModelCache::getPrototypeMaterial(Core::WeakPointer<Core::Mesh> mesh) {
+    std::unordered_map<Core::UInt64, Core::WeakPointer<Core::Material>>::iterator itr = this->meshPrototypes.find(mesh->getObjectID());
+    if (itr == this->meshPrototypes.end()) return Core::WeakPointer<Core::Material>();
+    return itr->second;
+}
+
+std::string ModelCache::getKey(const ImportSettings& settings) {
+    std::ostringstream ss;
+    ss << settings.path << "|" << settings.scale << "|" << settings.smoothingThreshold << "|"
+       << settings.preserveFBXPivots << "|" << settings.usePhysicalMaterial << "|" << settings.optimizeMeshes << "|" << settings.blended;
+    return ss.str();
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <QMutex>
+
+#include "Core/Engine.h"
+
+#include "AssetDependencyGraph.h"
+#include "ModelDescription.h"
+#include "ModelBuilder.h"
+#include "GeometryRegistry.h"
+
+// Caches imported models by path + import settings. Each file is parsed once; the
+// GPU resources built from it are shared by every instance created afterwards.
+class ModelCache {
+public:
+    using LoadCallback = std::function<void(std::shared_ptr<ModelDescription>)>;
+
+    ModelCache();
+
+    // Callable from any thread. The callback runs on a worker thread once the model
+    // has been parsed, or immediately if it already has; a failed import yields nullptr.
+    void load(const ImportSettings& settings, LoadCallback callback);
+
+    // Render thread only.
+    std::shared_ptr<ModelResources> getResources(Core::WeakPointer<Core::Engine> engine, std::shared_ptr<ModelDescription> description,
+                                                 LazyTextureLoader& textureLoader);
+
+    // Render thread only. The prototype material a mesh built by getResources() was
+    // instantiated from, or an invalid pointer for meshes that didn't come from here or
+    // that are shared by imports with different materials.
+    Core::WeakPointer<Core::Material> getPrototypeMaterial(Core::WeakPointer<Core::Mesh> mesh);
+
+    // Loads the dependency graph of earlier imports and checks every result against its
+    // sources on the pool. Stale ones are re-imported in parallel, except where a load() of
+    // the same key got there first (its parse does the same check); a load() arriving during
+    // a rebuild waits on it. Rebuilt results only go back to disk, nothing is kept resident
+    // unless a load() asked for it. Current ones are read from ModelBinaryCache when requested.
+    // Call once, before the first load().
+    void rebuildStale();
+
+    static std::string getKey(const ImportSettings& settings);
+
+private:
+    class Entry {
+    public:
+        std::shared_ptr<ModelDescription> description;
+        std::shared_ptr<ModelResources> resources;
+        std::vector<LoadCallback> pendingCallbacks;
+        // a parse for this key is queued or running
+        Core::Bool parsing = false;
+    };
+
+    void parse(const std::string& key, const ImportSettings& settings);
+    std::shared_ptr<ModelDescription> readOrImport(const std::string& key, const ImportSettings& settings);
+    void invalidate(const std::string& key, const ImportSettings& settings);
+
+    QMutex entriesMutex;
+    std::unordered_map<std::string, Entry> entries;
+    AssetDependencyGraph dependencies;
+    // mesh object ID -> prototype, meshes are shared by all instances so this only grows with the cache
+    std::unordered_map<Core::UInt64, Core::WeakPointer<Core::Material>> meshPrototypes;
+    // render thread only
+    GeometryRegistry geometry;
+};
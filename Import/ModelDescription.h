@@ -0,0 +1,150 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Core/common/types.h"
+#include "Core/color/Color.h"
+#include "Core/math/Matrix4x4.h"
+
+// CPU-side result of a model import. Everything in here is produced on a worker
+// thread and only turned into engine objects (meshes, textures, materials) on the
+// render thread by ModelBuilder.
+
+// Vertex/index storage that either owns its elements or points at memory owned by
+// someone else (a mapped cache file), so baked arrays can be uploaded in place.
+// Only owned arrays may be written to.
+template <typename T>
+class DataArray {
+public:
+    void resize(size_t count) { this->external = nullptr; this->owned.resize(count); }
+    void reserve(size_t count) { this->owned.reserve(count); }
+    void push_back(const T& value) { this->owned.push_back(value); }
+    void assign(std::vector<T>&& values) { this->external = nullptr; this->owned = std::move(values); }
+    void setExternal(const T* data, size_t count) {
+        this->owned.clear();
+        this->external = count > 0 ? data : nullptr;
+        this->externalCount = count;
+    }
+
+    size_t size() const { return this->external ? this->externalCount : this->owned.size(); }
+    const T* data() const { return this->external ? this->external : this->owned.data(); }
+    const T& operator[](size_t index) const { return this->data()[index]; }
+    T& operator[](size_t index) { return this->owned[index]; }
+
+private:
+    std::vector<T> owned;
+    const T* external = nullptr;
+    size_t externalCount = 0;
+};
+
+class ImportSettings {
+public:
+    std::string path;
+    Core::Real scale = 1.0f;
+    Core::Real smoothingThreshold = 0.0f;
+    Core::Bool castShadows = true;
+    Core::Bool preserveFBXPivots = true;
+    Core::Bool usePhysicalMaterial = true;
+    // reorder triangles & vertices for the GPU at import (see MeshOptimizer)
+    Core::Bool optimizeMeshes = true;
+    // the scene draws the meshes alpha-blended, where draw order shows, so the optimizer leaves out
+    // its overdraw sort
+    Core::Bool blended = false;
+};
+
+// Only the resolved path; the image itself is decoded after the model is in the scene.
+class ImageDescription {
+public:
+    std::string path;
+};
+
+class MaterialDescription {
+public:
+    std::string name;
+    Core::Color diffuseColor;
+    Core::Real opacity = 1.0f;
+    Core::Int32 albedoImage = -1;
+    Core::Int32 normalImage = -1;
+};
+
+class MeshDescription {
+public:
+    static const Core::UInt32 PositionComponentCount = 4;
+    static const Core::UInt32 NormalComponentCount = 4;
+    static const Core::UInt32 ColorComponentCount = 4;
+    static const Core::UInt32 UVComponentCount = 2;
+
+    std::string name;
+    Core::UInt32 vertexCount = 0;
+    Core::UInt32 materialIndex = 0;
+    DataArray<Core::Real> positions;
+    DataArray<Core::Real> normals;
+    DataArray<Core::Real> faceNormals;
+    DataArray<Core::Real> tangents;
+    DataArray<Core::Real> colors;
+    DataArray<Core::Real> uvs;
+    DataArray<Core::UInt32> indices;
+    // of the geometry above (see GeometryRegistry::hash), set when the model is parsed, not baked
+    Core::UInt64 contentHash = 0;
+};
+
+class NodeDescription {
+public:
+    std::string name;
+    Core::Matrix4x4 localTransform;
+    std::vector<Core::UInt32> meshes;
+    std::vector<Core::UInt32> children;
+};
+
+class ModelDescription {
+public:
+    ImportSettings settings;
+
+    // nodes[0] is always the root of the hierarchy
+    std::vector<NodeDescription> nodes;
+    std::vector<MeshDescription> meshes;
+    std::vector<MaterialDescription> materials;
+    std::vector<ImageDescription> images;
+
+    // Skinned meshes still go through Core::ModelLoader, which owns skeleton setup, so a
+    // description with this set carries nothing else (see ModelImporter::importModel())
+    Core::Bool hasSkinnedMeshes = false;
+
+    // keeps externally owned mesh arrays (see DataArray) alive, e.g. the mapped cache file
+    std::shared_ptr<void> backingStore;
+};
+
+// Animation clips are imported the same way: keyframes are read on a worker, and only the
+// Core::Animation is created on the render thread (ModelBuilder::buildAnimation()).
+
+class VectorKeyDescription {
+public:
+    Core::Real time = 0.0f;
+    Core::Real value[3] = {0.0f, 0.0f, 0.0f};
+};
+
+class RotationKeyDescription {
+public:
+    Core::Real time = 0.0f;
+    // x, y, z, w
+    Core::Real value[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+};
+
+// The keyframes of the node called nodeName, key times in ticks.
+class AnimationChannelDescription {
+public:
+    std::string nodeName;
+    std::vector<VectorKeyDescription> translations;
+    std::vector<RotationKeyDescription> rotations;
+    std::vector<VectorKeyDescription> scales;
+};
+
+class AnimationDescription {
+public:
+    std::string path;
+    Core::Real durationTicks = 0.0f;
+    Core::Real ticksPerSecond = 0.0f;
+    std::vector<AnimationChannelDescription> channels;
+};
@@ -0,0 +1,315 @@
+#include "ModelImporter.h"
+#include "Exception.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include <QFileInfo>
+#include <QDir>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include <assimp/config.h>
+
+#include "Core/image/ImageLoader.h"
+
+#include "MappedIOSystem.h"
+#include "MeshOptimizer.h"
+#include "MappedImageSource.h"
+#include "NormalGenerator.h"
+#include "Util/DevILLock.h"
+#include "Util/StartupTimeline.h"
+
+const std::string ModelImporter::FallbackTexturePath = "assets/textures/";
+
+namespace {
+    void convertMatrix(const aiMatrix4x4& src, Core::Matrix4x4& dest) {
+        Core::Real* data = dest.getData();
+        for (Core::UInt32 row = 0; row < 4; row++) {
+            for (Core::UInt32 col = 0; col < 4; col++) {
+                data[col * 4 + row] = src[row][col];
+            }
+        }
+    }
+}
+
+ModelImporter::ModelImporter() {
+
+}
+
+std::shared_ptr<ModelDescription> ModelImporter::importModel(const ImportSettings& settings) {
+    StartupTimeline::Scope timelineScope("ModelImporter::importModel");
+    Assimp::Importer importer;
+    // the importer takes ownership
+    importer.SetIOHandler(new MappedIOSystem());
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, settings.preserveFBXPivots);
+    const aiScene* scene = importer.ReadFile(settings.path, 0);
+    if (scene == nullptr || scene->mRootNode == nullptr) {
+        throw Exception(std::string("ModelImporter::importModel() -> Unable to import '") + settings.path + "': " + importer.GetErrorString());
+    }
+
+    std::shared_ptr<ModelDescription> description = std::make_shared<ModelDescription>();
+    description->settings = settings;
+
+    // skinned models are built by Core's loader from the file, so they stop here, before any post-processing,
+    // normals or texture lookups; the result is only the flag, which the binary cache keeps for later runs
+    for (Core::UInt32 i = 0; i < scene->mNumMeshes; i++) {
+        if (scene->mMeshes[i]->HasBones()) {
+            description->hasSkinnedMeshes = true;
+            return description;
+        }
+    }
+
+    scene = importer.ApplyPostProcessing(aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_CalcTangentSpace | aiProcess_SortByPType);
+    if (scene == nullptr || scene->mRootNode == nullptr) {
+        throw Exception(std::string("ModelImporter::importModel() -> Unable to import '") + settings.path + "': " + importer.GetErrorString());
+    }
+
+    std::string modelDirectory = QFileInfo(QString::fromStdString(settings.path)).absolutePath().toStdString();
+    ImageIndexMap imageIndices;
+    description->materials.resize(scene->mNumMaterials);
+    for (Core::UInt32 i = 0; i < scene->mNumMaterials; i++) {
+        importMaterial(scene->mMaterials[i], modelDirectory, *description, imageIndices, description->materials[i]);
+    }
+
+    description->meshes.resize(scene->mNumMeshes);
+    for (Core::UInt32 i = 0; i < scene->mNumMeshes; i++) {
+        importMesh(scene->mMeshes[i], description->meshes[i]);
+        NormalGenerator::computeNormals(description->meshes[i], settings.smoothingThreshold);
+    }
+
+    if (settings.optimizeMeshes) {
+        StartupTimeline::Scope optimizeScope("MeshOptimizer::optimize");
+        MeshOptimizer::Statistics statistics;
+        for (MeshDescription& mesh : description->meshes) {
+            MeshOptimizer::optimize(mesh, settings.blended, statistics);
+        }
+        std::cout << "ModelImporter::importModel() -> Optimized " << statistics.meshCount << " meshes of '" << settings.path << "' ("
+                  << statistics.triangleCount << " triangles" << (settings.blended ? ", blended" : "") << "): ACMR "
+                  << statistics.getACMRBefore() << " -> " << statistics.getACMRAfter();
+        if (MeshOptimizer::isOverdrawMeasured()) {
+            std::cout << ", overdraw " << statistics.getOverdrawBefore() << " -> " << statistics.getOverdrawAfter();
+        }
+        std::cout << ", " << statistics.shortIndexMeshCount << " meshes fit 16-bit indices" << std::endl;
+    }
+
+    importNode(scene->mRootNode, *description);
+
+    Core::Matrix4x4 scaleMatrix;
+    scaleMatrix.makeScale(settings.scale, settings.scale, settings.scale);
+    description->nodes[0].localTransform.preMultiply(scaleMatrix);
+
+    return description;
+}
+
+std::shared_ptr<AnimationDescription> ModelImporter::importAnimation(const std::string& path, Core::Bool addLoopPadding, Core::Bool preserveFBXPivots) {
+    StartupTimeline::Scope timelineScope("ModelImporter::importAnimation");
+    Assimp::Importer importer;
+    importer.SetIOHandler(new MappedIOSystem());
+    // channels are matched to skeleton nodes by name, so this has to agree with how the model was loaded
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, preserveFBXPivots);
+    const aiScene* scene = importer.ReadFile(path, 0);
+    if (scene == nullptr || scene->mNumAnimations == 0) {
+        throw Exception(std::string("ModelImporter::importAnimation() -> Unable to import an animation from '") + path + "': " + importer.GetErrorString());
+    }
+
+    const aiAnimation* aiAnimation = scene->mAnimations[0];
+    std::shared_ptr<AnimationDescription> description = std::make_shared<AnimationDescription>();
+    description->path = path;
+    description->durationTicks = (Core::Real)aiAnimation->mDuration;
+    // zero means the file didn't say; Assimp's own fallback
+    description->ticksPerSecond = aiAnimation->mTicksPerSecond > 0.0 ? (Core::Real)aiAnimation->mTicksPerSecond : 25.0f;
+    description->channels.resize(aiAnimation->mNumChannels);
+    size_t maxKeyCount = 0;
+    for (Core::UInt32 i = 0; i < aiAnimation->mNumChannels; i++) {
+        AnimationChannelDescription& channel = description->channels[i];
+        importChannel(aiAnimation->mChannels[i], channel);
+        maxKeyCount = std::max({maxKeyCount, channel.translations.size(), channel.rotations.size(), channel.scales.size()});
+    }
+
+    if (addLoopPadding && maxKeyCount > 1) {
+        Core::Real padding = description->durationTicks / (Core::Real)(maxKeyCount - 1);
+        description->durationTicks += padding;
+        for (AnimationChannelDescription& channel : description->channels) {
+            if (channel.translations.size() > 0) {
+                channel.translations.push_back(channel.translations.front());
+                channel.translations.back().time = description->durationTicks;
+            }
+            if (channel.rotations.size() > 0) {
+                channel.rotations.push_back(channel.rotations.front());
+                channel.rotations.back().time = description->durationTicks;
+            }
+            if (channel.scales.size() > 0) {
+                channel.scales.push_back(channel.scales.front());
+                channel.scales.back().time = description->durationTicks;
+            }
+        }
+    }
+
+    return description;
+}
+
+Core::UInt32 ModelImporter::importNode(const aiNode* aiNode, ModelDescription& description) {
+    Core::UInt32 nodeIndex = description.nodes.size();
+    description.nodes.emplace_back();
+    NodeDescription& node = description.nodes[nodeIndex];
+    node.name = aiNode->mName.C_Str();
+    convertMatrix(aiNode->mTransformation, node.localTransform);
+    for (Core::UInt32 i = 0; i < aiNode->mNumMeshes; i++) {
+        node.meshes.push_back(aiNode->mMeshes[i]);
+    }
+
+    for (Core::UInt32 i = 0; i < aiNode->mNumChildren; i++) {
+        Core::UInt32 childIndex = importNode(aiNode->mChildren[i], description);
+        description.nodes[nodeIndex].children.push_back(childIndex);
+    }
+    return nodeIndex;
+}
+
+void ModelImporter::importMesh(const aiMesh* aiMesh, MeshDescription& mesh) {
+    mesh.name = aiMesh->mName.C_Str();
+    mesh.materialIndex = aiMesh->mMaterialIndex;
+    mesh.vertexCount = aiMesh->mNumVertices;
+
+    mesh.positions.resize(mesh.vertexCount * MeshDescription::PositionComponentCount);
+    for (Core::UInt32 v = 0; v < mesh.vertexCount; v++) {
+        Core::Real* position = &mesh.positions[v * MeshDescription::PositionComponentCount];
+        position[0] = aiMesh->mVertices[v].x;
+        position[1] = aiMesh->mVertices[v].y;
+        position[2] = aiMesh->mVertices[v].z;
+        position[3] = 1.0f;
+    }
+
+    if (aiMesh->HasTangentsAndBitangents()) {
+        mesh.tangents.resize(mesh.vertexCount * MeshDescription::NormalComponentCount);
+        for (Core::UInt32 v = 0; v < mesh.vertexCount; v++) {
+            Core::Real* tangent = &mesh.tangents[v * MeshDescription::NormalComponentCount];
+            tangent[0] = aiMesh->mTangents[v].x;
+            tangent[1] = aiMesh->mTangents[v].y;
+            tangent[2] = aiMesh->mTangents[v].z;
+            tangent[3] = 0.0f;
+        }
+    }
+
+    if (aiMesh->HasVertexColors(0)) {
+        mesh.colors.resize(mesh.vertexCount * MeshDescription::ColorComponentCount);
+        for (Core::UInt32 v = 0; v < mesh.vertexCount; v++) {
+            Core::Real* color = &mesh.colors[v * MeshDescription::ColorComponentCount];
+            color[0] = aiMesh->mColors[0][v].r;
+            color[1] = aiMesh->mColors[0][v].g;
+            color[2] = aiMesh->mColors[0][v].b;
+            color[3] = aiMesh->mColors[0][v].a;
+        }
+    }
+
+    if (aiMesh->HasTextureCoords(0)) {
+        mesh.uvs.resize(mesh.vertexCount * MeshDescription::UVComponentCount);
+        for (Core::UInt32 v = 0; v < mesh.vertexCount; v++) {
+            Core::Real* uv = &mesh.uvs[v * MeshDescription::UVComponentCount];
+            uv[0] = aiMesh->mTextureCoords[0][v].x;
+            uv[1] = aiMesh->mTextureCoords[0][v].y;
+        }
+    }
+
+    mesh.indices.reserve(aiMesh->mNumFaces * 3);
+    for (Core::UInt32 f = 0; f < aiMesh->mNumFaces; f++) {
+        const aiFace& face = aiMesh->mFaces[f];
+        if (face.mNumIndices != 3) continue;
+        mesh.indices.push_back(face.mIndices[0]);
+        mesh.indices.push_back(face.mIndices[1]);
+        mesh.indices.push_back(face.mIndices[2]);
+    }
+}
+
+void ModelImporter::importChannel(const aiNodeAnim* aiChannel, AnimationChannelDescription& channel) {
+    channel.nodeName = aiChannel->mNodeName.C_Str();
+    channel.translations.resize(aiChannel->mNumPositionKeys);
+    for (Core::UInt32 i = 0; i < aiChannel->mNumPositionKeys; i++) {
+        const aiVectorKey& key = aiChannel->mPositionKeys[i];
+        channel.translations[i].time = (Core::Real)key.mTime;
+        channel.translations[i].value[0] = key.mValue.x;
+        channel.translations[i].value[1] = key.mValue.y;
+        channel.translations[i].value[2] = key.mValue.z;
+    }
+    channel.rotations.resize(aiChannel->mNumRotationKeys);
+    for (Core::UInt32 i = 0; i < aiChannel->mNumRotationKeys; i++) {
+        const aiQuatKey& key = aiChannel->mRotationKeys[i];
+        channel.rotations[i].time = (Core::Real)key.mTime;
+        channel.rotations[i].value[0] = key.mValue.x;
+        channel.rotations[i].value[1] = key.mValue.y;
+        channel.rotations[i].value[2] = key.mValue.z;
+        channel.rotations[i].value[3] = key.mValue.w;
+    }
+    channel.scales.resize(aiChannel->mNumScalingKeys);
+    for (Core::UInt32 i = 0; i < aiChannel->mNumScalingKeys; i++) {
+        const aiVectorKey& key = aiChannel->mScalingKeys[i];
+        channel.scales[i].time = (Core::Real)key.mTime;
+        channel.scales[i].value[0] = key.mValue.x;
+        channel.scales[i].value[1] = key.mValue.y;
+        channel.scales[i].value[2] = key.mValue.z;
+    }
+}
+
+void ModelImporter::importMaterial(const aiMaterial* aiMaterial, const std::string& modelDirectory, ModelDescription& description,
+                                   ImageIndexMap& imageIndices, MaterialDescription& material) {
+    aiString name;
+    if (aiMaterial->Get(AI_MATKEY_NAME, name) == AI_SUCCESS) material.name = name.C_Str();
+
+    aiColor4D diffuseColor(1.0f, 1.0f, 1.0f, 1.0f);
+    aiMaterial->Get(AI_MATKEY_COLOR_DIFFUSE, diffuseColor);
+    material.diffuseColor.set(diffuseColor.r, diffuseColor.g, diffuseColor.b, diffuseColor.a);
+
+    float opacity = 1.0f;
+    if (aiMaterial->Get(AI_MATKEY_OPACITY, opacity) == AI_SUCCESS) material.opacity = opacity;
+
+    aiString texturePath;
+    if (aiMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &texturePath) == AI_SUCCESS) {
+        material.albedoImage = importImage(texturePath.C_Str(), modelDirectory, description, imageIndices);
+    }
+    if (aiMaterial->GetTexture(aiTextureType_NORMALS, 0, &texturePath) == AI_SUCCESS) {
+        material.normalImage = importImage(texturePath.C_Str(), modelDirectory, description, imageIndices);
+    }
+}
+
+Core::Int32 ModelImporter::importImage(const std::string& texturePath, const std::string& modelDirectory, ModelDescription& description, ImageIndexMap& imageIndices) {
+    // embedded textures ("*0", "*1", ...) are not supported
+    if (texturePath.size() == 0 || texturePath[0] == '*') return -1;
+
+    std::string fullPath = resolveTexturePath(texturePath, modelDirectory);
+    if (fullPath.size() == 0) return -1;
+
+    ImageIndexMap::iterator existing = imageIndices.find(fullPath);
+    if (existing != imageIndices.end()) return existing->second;
+
+    Core::Int32 imageIndex = description.images.size();
+    description.images.emplace_back();
+    description.images[imageIndex].path = fullPath;
+    imageIndices[fullPath] = imageIndex;
+    return imageIndex;
+}
+
+std::shared_ptr<Core::StandardImage> ModelImporter::loadImage(const std::string& fullPath) {
+    std::shared_ptr<Core::StandardImage> image = MappedImageSource::loadImageU(fullPath, false, true);
+    if (image) return image;
+    // let Core's loader have a go at anything DevIL couldn't identify from memory
+    StartupTimeline::addBytesRead(QFileInfo(QString::fromStdString(fullPath)).size());
+    DevILLock devILLock;
+    return Core::ImageLoader::loadImageU(fullPath, false, true);
+}
+
+std::string ModelImporter::resolveTexturePath(const std::string& texturePath, const std::string& modelDirectory) {
+    QString qTexturePath = QString::fromStdString(texturePath);
+    qTexturePath.replace('\\', '/');
+    QFileInfo asGiven(QDir(QString::fromStdString(modelDirectory)), qTexturePath);
+    if (asGiven.exists()) return asGiven.absoluteFilePath().toStdString();
+
+    QString fileName = QFileInfo(qTexturePath).fileName();
+    QFileInfo besideModel(QDir(QString::fromStdString(modelDirectory)), fileName);
+    if (besideModel.exists()) return besideModel.absoluteFilePath().toStdString();
+
+    QFileInfo inFallback(QDir(QString::fromStdString(FallbackTexturePath)), fileName);
+    if (inFallback.exists()) return inFallback.absoluteFilePath().toStdString();
+
+    return std::string();
+}
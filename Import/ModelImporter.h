@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <QMutex>
+
+#include "Core/image/StandardImage.h"
+
+#include "ModelDescription.h"
+
+struct aiScene;
+struct aiNode;
+struct aiMesh;
+struct aiMaterial;
+struct aiNodeAnim;
+
+class ModelImporter {
+public:
+    static const std::string FallbackTexturePath;
+
+    ModelImporter();
+    static std::shared_ptr<ModelDescription> importModel(const ImportSettings& settings);
+    // The file's first animation. With addLoopPadding every channel gets its first key again one
+    // key interval past the end, so a looping clip blends back into its start.
+    static std::shared_ptr<AnimationDescription> importAnimation(const std::string& path, Core::Bool addLoopPadding, Core::Bool preserveFBXPivots);
+    static std::shared_ptr<Core::StandardImage> loadImage(const std::string& fullPath);
+
+private:
+    using ImageIndexMap = std::unordered_map<std::string, Core::Int32>;
+
+    static Core::UInt32 importNode(const aiNode* aiNode, ModelDescription& description);
+    static void importMesh(const aiMesh* aiMesh, MeshDescription& mesh);
+    static void importChannel(const aiNodeAnim* aiChannel, AnimationChannelDescription& channel);
+    static void importMaterial(const aiMaterial* aiMaterial, const std::string& modelDirectory, ModelDescription& description, ImageIndexMap& imageIndices, MaterialDescription& material);
+    static Core::Int32 importImage(const std::string& texturePath, const std::string& modelDirectory, ModelDescription& description, ImageIndexMap& imageIndices);
+    static std::string resolveTexturePath(const std::string& texturePath, const std::string& modelDirectory);
+};
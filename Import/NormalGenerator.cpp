@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include <QSemaphore>
+#include <QThreadPool>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define NORMAL_GENERATOR_SSE 1
+#include <xmmintrin.h>
+#endif
+
+#include "NormalGenerator.h"
+
+const Core::UInt32 NormalGenerator::MinParallelVertices = 16384;
+
+namespace {
+    using RangeFunction = std::function<void(Core::UInt32, Core::UInt32)>;
+
+    // Runs body over [0, count) in chunks. The calling thread always takes part and helpers
+    // are only started on pool threads that are idle right now, so this is safe to call from
+    // an import that is itself running on the pool.
+    void parallelFor(Core::UInt32 count, Core::UInt32 chunkSize, bool parallel, const RangeFunction& body) {
+        const Core::UInt32 chunkCount = (count + chunkSize - 1) / chunkSize;
+        std::atomic<Core::UInt32> nextChunk(0);
+        std::function<void()> run = [&nextChunk, chunkCount, chunkSize, count, &body]() {
+            for (Core::UInt32 chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) {
+                Core::UInt32 begin = chunk * chunkSize;
+                body(begin, std::min(begin + chunkSize, count));
+            }
+        };
+
+        QSemaphore finished;
+        Core::UInt32 helpers = 0;
+        if (parallel) {
+            QThreadPool* pool = QThreadPool::globalInstance();
+            while (helpers + 1 < chunkCount && (Core::Int32)helpers + 1 < pool->maxThreadCount()) {
+                if (!pool->tryStart([&run, &finished]() {
+                    run();
+                    finished.release();
+                })) break;
+                helpers++;
+            }
+        }
+        run();
+        finished.acquire(helpers);
+    }
+
+    Core::UInt32 hashPosition(const Core::Real* position) {
+        Core::UInt32 bits[3];
+        for (Core::UInt32 i = 0; i < 3; i++) {
+            // -0 and 0 compare equal, so they have to land in the same bucket
+            float value = position[i] == 0.0f ? 0.0f : (float)position[i];
+            memcpy(&bits[i], &value, sizeof(Core::UInt32));
+        }
+        Core::UInt32 hash = (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+        // round coordinates have all-zero low mantissa bits, so fold the high bits down before masking
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6bu;
+        hash ^= hash >> 13;
+        hash *= 0xc2b2ae35u;
+        hash ^= hash >> 16;
+        return hash;
+    }
+
+    bool samePosition(const Core::Real* a, const Core::Real* b) {
+        return a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+    }
+
+    // Sums the candidate normals (x/y/z arrays padded to a multiple of four with zeros)
+    // within the threshold of own.
+    void sumWithinThreshold(const std::vector<float>& x, const std::vector<float>& y, const std::vector<float>& z,
+                            const Core::Real own[3], Core::Real minDot, Core::Real sum[3]) {
+        const Core::UInt32 count = x.size();
+#ifdef NORMAL_GENERATOR_SSE
+        static_assert(std::is_same<Core::Real, float>::value, "SSE normal smoothing assumes single precision reals");
+        const __m128 ownX = _mm_set1_ps(own[0]), ownY = _mm_set1_ps(own[1]), ownZ = _mm_set1_ps(own[2]);
+        const __m128 threshold = _mm_set1_ps(minDot);
+        __m128 sumX = _mm_setzero_ps(), sumY = _mm_setzero_ps(), sumZ = _mm_setzero_ps();
+        for (Core::UInt32 i = 0; i < count; i += 4) {
+            __m128 nx = _mm_loadu_ps(&x[i]), ny = _mm_loadu_ps(&y[i]), nz = _mm_loadu_ps(&z[i]);
+            __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, ownX), _mm_mul_ps(ny, ownY)), _mm_mul_ps(nz, ownZ));
+            __m128 mask = _mm_cmpge_ps(dot, threshold);
+            sumX = _mm_add_ps(sumX, _mm_and_ps(mask, nx));
+            sumY = _mm_add_ps(sumY, _mm_and_ps(mask, ny));
+            sumZ = _mm_add_ps(sumZ, _mm_and_ps(mask, nz));
+        }
+        float lanes[3][4];
+        _mm_storeu_ps(lanes[0], sumX);
+        _mm_storeu_ps(lanes[1], sumY);
+        _mm_storeu_ps(lanes[2], sumZ);
+        for (Core::UInt32 c = 0; c < 3; c++) {
+            sum[c] = lanes[c][0] + lanes[c][1] + lanes[c][2] + lanes[c][3];
+        }
+#else
+        sum[0] = sum[1] = sum[2] = 0.0f;
+        for (Core::UInt32 i = 0; i < count; i++) {
+            if (x[i] * own[0] + y[i] * own[1] + z[i] * own[2] < minDot) continue;
+            sum[0] += x[i]; sum[1] += y[i]; sum[2] += z[i];
+        }
+#endif
+    }
+
+    void normalize(Core::Real v[3]) {
+        Core::Real length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        if (length > 0.0f) {
+            v[0] /= length; v[1] /= length; v[2] /= length;
+        }
+    }
+}
+
+void NormalGenerator::computeNormals(MeshDescription& mesh, Core::Real smoothingThreshold) {
+    const Core::UInt32 vertexCount = mesh.vertexCount;
+    const Core::UInt32 faceCount = mesh.indices.size() / 3;
+    const Core::Real* positions = mesh.positions.data();
+    const Core::UInt32* indices = mesh.indices.data();
+    const bool parallel = vertexCount >= MinParallelVertices;
+
+    mesh.normals.resize(vertexCount * MeshDescription::NormalComponentCount);
+    mesh.faceNormals.resize(vertexCount * MeshDescription::NormalComponentCount);
+    if (vertexCount == 0) return;
+    Core::Real* normals = &mesh.normals[0];
+    Core::Real* faceNormalsOut = &mesh.faceNormals[0];
+
+    std::vector<Core::Real> faceNormals(faceCount * 3);
+    parallelFor(faceCount, 8192, parallel, [positions, indices, &faceNormals](Core::UInt32 begin, Core::UInt32 end) {
+        for (Core::UInt32 f = begin; f < end; f++) {
+            const Core::Real* a = &positions[indices[f * 3] * MeshDescription::PositionComponentCount];
+            const Core::Real* b = &positions[indices[f * 3 + 1] * MeshDescription::PositionComponentCount];
+            const Core::Real* c = &positions[indices[f * 3 + 2] * MeshDescription::PositionComponentCount];
+            Core::Real abx = b[0] - a[0], aby = b[1] - a[1], abz = b[2] - a[2];
+            Core::Real acx = c[0] - a[0], acy = c[1] - a[1], acz = c[2] - a[2];
+            Core::Real* n = &faceNormals[f * 3];
+            n[0] = aby * acz - abz * acy;
+            n[1] = abz * acx - abx * acz;
+            n[2] = abx * acy - aby * acx;
+            normalize(n);
+        }
+    });
+
+    // faces touching each vertex, in compressed (offset + list) form
+    std::vector<Core::UInt32> vertexFaceOffsets(vertexCount + 1, 0);
+    for (Core::UInt32 i = 0; i < faceCount * 3; i++) vertexFaceOffsets[indices[i] + 1]++;
+    for (Core::UInt32 v = 0; v < vertexCount; v++) vertexFaceOffsets[v + 1] += vertexFaceOffsets[v];
+    std::vector<Core::UInt32> vertexFaces(faceCount * 3);
+    std::vector<Core::UInt32> fill(vertexFaceOffsets.begin(), vertexFaceOffsets.end() - 1);
+    for (Core::UInt32 i = 0; i < faceCount * 3; i++) vertexFaces[fill[indices[i]]++] = i / 3;
+
+    // each vertex's own normal, which is also its face normal output
+    parallelFor(vertexCount, 8192, parallel, [&](Core::UInt32 begin, Core::UInt32 end) {
+        for (Core::UInt32 v = begin; v < end; v++) {
+            Core::Real own[3] = {0.0f, 0.0f, 0.0f};
+            for (Core::UInt32 i = vertexFaceOffsets[v]; i < vertexFaceOffsets[v + 1]; i++) {
+                const Core::Real* n = &faceNormals[vertexFaces[i] * 3];
+                own[0] += n[0]; own[1] += n[1]; own[2] += n[2];
+            }
+            normalize(own);
+            Core::Real* faceNormal = &faceNormalsOut[v * MeshDescription::NormalComponentCount];
+            faceNormal[0] = own[0]; faceNormal[1] = own[1]; faceNormal[2] = own[2]; faceNormal[3] = 0.0f;
+        }
+    });
+
+    // group vertices that share a position exactly (split by UV/tangent seams during import)
+    // through an open addressing table of the first vertex seen at each position
+    Core::UInt32 tableSize = 2;
+    while (tableSize < vertexCount * 2) tableSize <<= 1;
+    const Core::UInt32 tableMask = tableSize - 1;
+    std::vector<Core::UInt32> vertexHashes(vertexCount);
+    parallelFor(vertexCount, 8192, parallel, [positions, &vertexHashes](Core::UInt32 begin, Core::UInt32 end) {
+        for (Core::UInt32 v = begin; v < end; v++) {
+            vertexHashes[v] = hashPosition(&positions[v * MeshDescription::PositionComponentCount]);
+        }
+    });
+    const Core::UInt32 Empty = 0xFFFFFFFF;
+    std::vector<Core::UInt32> table(tableSize, Empty);
+    std::vector<Core::UInt32> groupOffsets(vertexCount + 1, 0);
+    std::vector<Core::UInt32> vertexGroups(vertexCount);
+    for (Core::UInt32 v = 0; v < vertexCount; v++) {
+        const Core::Real* position = &positions[v * MeshDescription::PositionComponentCount];
+        Core::UInt32 slot = vertexHashes[v] & tableMask;
+        while (table[slot] != Empty && !samePosition(&positions[table[slot] * MeshDescription::PositionComponentCount], position)) {
+            slot = (slot + 1) & tableMask;
+        }
+        if (table[slot] == Empty) table[slot] = v;
+        // groups are numbered by their first vertex, so they come out in roughly vertex order
+        vertexGroups[v] = table[slot];
+        groupOffsets[table[slot] + 1]++;
+    }
+    for (Core::UInt32 v = 0; v < vertexCount; v++) groupOffsets[v + 1] += groupOffsets[v];
+    std::vector<Core::UInt32> groupVertices(vertexCount);
+    fill.assign(groupOffsets.begin(), groupOffsets.end() - 1);
+    for (Core::UInt32 v = 0; v < vertexCount; v++) groupVertices[fill[vertexGroups[v]]++] = v;
+
+    const Core::Real minDot = std::cos(smoothingThreshold);
+    parallelFor(vertexCount, 4096, parallel, [&](Core::UInt32 begin, Core::UInt32 end) {
+        std::vector<float> x, y, z;
+        for (Core::UInt32 g = begin; g < end; g++) {
+            if (groupOffsets[g] == groupOffsets[g + 1]) continue;
+
+            x.clear(); y.clear(); z.clear();
+            for (Core::UInt32 o = groupOffsets[g]; o < groupOffsets[g + 1]; o++) {
+                Core::UInt32 other = groupVertices[o];
+                for (Core::UInt32 i = vertexFaceOffsets[other]; i < vertexFaceOffsets[other + 1]; i++) {
+                    const Core::Real* n = &faceNormals[vertexFaces[i] * 3];
+                    x.push_back(n[0]); y.push_back(n[1]); z.push_back(n[2]);
+                }
+            }
+            // the zero padding passes the test for thresholds of 90 degrees and up, but adds nothing
+            while (x.size() % 4 != 0) {
+                x.push_back(0.0f); y.push_back(0.0f); z.push_back(0.0f);
+            }
+
+            for (Core::UInt32 o = groupOffsets[g]; o < groupOffsets[g + 1]; o++) {
+                Core::UInt32 v = groupVertices[o];
+                const Core::Real* own = &faceNormalsOut[v * MeshDescription::NormalComponentCount];
+                Core::Real smooth[3];
+                sumWithinThreshold(x, y, z, own, minDot, smooth);
+                Core::Real smoothLength = std::sqrt(smooth[0] * smooth[0] + smooth[1] * smooth[1] + smooth[2] * smooth[2]);
+                if (smoothLength > 0.0f) {
+                    smooth[0] /= smoothLength; smooth[1] /= smoothLength; smooth[2] /= smoothLength;
+                } else {
+                    smooth[0] = own[0]; smooth[1] = own[1]; smooth[2] = own[2];
+                }
+
+                Core::Real* normal = &normals[v * MeshDescription::NormalComponentCount];
+                normal[0] = smooth[0]; normal[1] = smooth[1]; normal[2] = smooth[2]; normal[3] = 0.0f;
+            }
+        }
+    });
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Core/common/types.h"
+
+#include "ModelDescription.h"
+
+// Fills in vertex & face normals at import; faces whose normals differ by less than
+// smoothingThreshold (radians) are smoothed across vertices that share a position. Those
+// are grouped through a hash of their exact coordinates, and the groups are spread over
+// the calling thread plus whatever global pool threads are idle. Inside a group the face normals are laid out as separate x/y/z arrays and the
+// threshold test runs four faces at a time with SSE where available.
+//
+// The baker's --benchmark-normals times this against Core::Mesh::calculateNormals().
+class NormalGenerator {
+public:
+    // Work below this many vertices isn't worth handing to other threads.
+    static const Core::UInt32 MinParallelVertices;
+
+    static void computeNormals(MeshDescription& mesh, Core::Real smoothingThreshold);
+};
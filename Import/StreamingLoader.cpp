@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <iostream>
+
+#include <QThreadPool>
+
+#include "StreamingLoader.h"
+
+StreamingLoader::StreamingLoader(std::shared_ptr<FrameBudget> frameBudget): frameBudget(frameBudget) {
+    // keep every pool thread busy, but no more, so near loads never queue behind far ones
+    this->maxInFlight = std::max(QThreadPool::globalInstance()->maxThreadCount(), 1);
+}
+
+void StreamingLoader::request(Starter starter) {
+    Load load;
+    load.positioned = false;
+    load.starter = starter;
+    this->enqueue(load);
+}
+
+void StreamingLoader::request(const Core::Point3r& position, Starter starter) {
+    Load load;
+    load.positioned = true;
+    load.position = position;
+    load.starter = starter;
+    this->enqueue(load);
+}
+
+void StreamingLoader::enqueue(Load& load) {
+    QMutexLocker ml(&this->loadsMutex);
+    load.id = this->nextID++;
+    load.distance = 0.0f;
+    this->pending.push_back(load);
+    if (!this->streaming) {
+        this->streaming = true;
+        this->streamedCount = 0;
+        this->streamTimer.start();
+    }
+}
+
+void StreamingLoader::markReady(Core::UInt64 id, Finalizer finalizer) {
+    QMutexLocker ml(&this->loadsMutex);
+    for (std::vector<Load>::iterator itr = this->inFlight.begin(); itr != this->inFlight.end(); ++itr) {
+        if (itr->id == id) {
+            itr->finalizer = finalizer;
+            this->ready.push_back(*itr);
+            this->inFlight.erase(itr);
+            return;
+        }
+    }
+}
+
+void StreamingLoader::update(Core::WeakPointer<Core::Engine> engine, const Core::Point3r& cameraPosition) {
+    QElapsedTimer frameTimer;
+    frameTimer.start();
+    Core::Real budgetMs = this->frameBudget->getRemainingMs();
+
+    // start the nearest pending loads; starters run outside the lock since a cached model reports ready immediately
+    std::vector<Load> toStart;
+    {
+        QMutexLocker ml(&this->loadsMutex);
+        sortByDistance(this->pending, cameraPosition);
+        while (this->pending.size() > 0 && this->inFlight.size() < this->maxInFlight) {
+            toStart.push_back(this->pending.front());
+            this->inFlight.push_back(this->pending.front());
+            this->pending.erase(this->pending.begin());
+        }
+    }
+    for (Load& load : toStart) {
+        Core::UInt64 id = load.id;
+        load.starter([this, id](Finalizer finalizer) {
+            this->markReady(id, finalizer);
+        });
+    }
+
+    // finish the nearest ready loads, always at least one per frame so the stream keeps moving
+    std::vector<Load> toFinish;
+    {
+        QMutexLocker ml(&this->loadsMutex);
+        sortByDistance(this->ready, cameraPosition);
+        toFinish.swap(this->ready);
+    }
+    Core::UInt32 finished = 0;
+    for (; finished < toFinish.size(); finished++) {
+        if (finished > 0 && frameTimer.nsecsElapsed() / 1000000.0 >= budgetMs) break;
+        toFinish[finished].finalizer(engine);
+    }
+    this->frameBudget->consume(frameTimer.nsecsElapsed() / 1000000.0);
+
+    QMutexLocker ml(&this->loadsMutex);
+    if (finished < toFinish.size()) {
+        this->ready.insert(this->ready.end(), toFinish.begin() + finished, toFinish.end());
+    }
+    this->streamedCount += finished;
+    if (this->streaming && this->pending.size() == 0 && this->inFlight.size() == 0 && this->ready.size() == 0) {
+        this->streaming = false;
+        std::cout << "StreamingLoader::update() -> Streamed " << this->streamedCount << " loads in " << this->streamTimer.elapsed() << " ms" << std::endl;
+    }
+}
+
+void StreamingLoader::setMaxInFlight(Core::UInt32 maxInFlight) {
+    QMutexLocker ml(&this->loadsMutex);
+    this->maxInFlight = std::max(maxInFlight, (Core::UInt32)1);
+}
+
+Core::UInt32 StreamingLoader::getOutstandingCount() {
+    QMutexLocker ml(&this->loadsMutex);
+    return this->pending.size() + this->inFlight.size() + this->ready.size();
+}
+
+void StreamingLoader::sortByDistance(std::vector<Load>& loads, const Core::Point3r& cameraPosition) {
+    for (Load& load : loads) {
+        if (!load.positioned) continue;
+        Core::Vector3r toLoad = load.position - cameraPosition;
+        load.distance = toLoad.magnitude();
+    }
+    // unpositioned loads first, then nearest first, request order breaking ties
+    std::sort(loads.begin(), loads.end(), [](const Load& a, const Load& b) {
+        if (a.positioned != b.positioned) return !a.positioned;
+        if (a.distance != b.distance) return a.distance < b.distance;
+        return a.id < b.id;
+    });
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <QMutex>
+#include <QElapsedTimer>
+
+#include "Core/Engine.h"
+#include "Core/geometry/Vector3.h"
+
+#include "Util/FrameBudget.h"
+
+// Schedules model loads nearest-first. Pending loads are started in order of distance
+// from the render camera with a cap on how many are parsing at once, and the
+// render-thread half of finished loads (GPU upload, scene graph) runs nearest-first
+// out of the shared FrameBudget, so whatever is in front of the camera shows up first.
+class StreamingLoader {
+public:
+    // render-thread work that completes a load
+    using Finalizer = std::function<void(Core::WeakPointer<Core::Engine>)>;
+    // handed to a Starter; may be called from any thread once the CPU-side work is done
+    using ReadyCallback = std::function<void(Finalizer)>;
+    using Starter = std::function<void(ReadyCallback)>;
+
+    StreamingLoader(std::shared_ptr<FrameBudget> frameBudget);
+
+    // Loads requested without a position (e.g. from the GUI) go ahead of all positioned ones.
+    void request(Starter starter);
+    void request(const Core::Point3r& position, Starter starter);
+
+    // Render thread, once per frame.
+    void update(Core::WeakPointer<Core::Engine> engine, const Core::Point3r& cameraPosition);
+
+    void setMaxInFlight(Core::UInt32 maxInFlight);
+    Core::UInt32 getOutstandingCount();
+
+private:
+    class Load {
+    public:
+        Core::UInt64 id;
+        Core::Bool positioned;
+        Core::Point3r position;
+        Core::Real distance;
+        Starter starter;
+        Finalizer finalizer;
+    };
+
+    void enqueue(Load& load);
+    void markReady(Core::UInt64 id, Finalizer finalizer);
+    static void sortByDistance(std::vector<Load>& loads, const Core::Point3r& cameraPosition);
+
+    Core::UInt32 maxInFlight;
+    std::shared_ptr<FrameBudget> frameBudget;
+    Core::UInt64 nextID = 0;
+
+    // inFlight holds loads that were started and whose CPU side hasn't finished yet
+    QMutex loadsMutex;
+    std::vector<Load> pending;
+    std::vector<Load> inFlight;
+    std::vector<Load> ready;
+
+    Core::Bool streaming = false;
+    Core::UInt32 streamedCount = 0;
+    QElapsedTimer streamTimer;
+};
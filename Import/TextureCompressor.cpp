@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "TextureCompressor.h"
+
+namespace {
+    Core::UInt16 packColor565(Core::Int32 r, Core::Int32 g, Core::Int32 b) {
+        return (Core::UInt16)(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+    }
+
+    void unpackColor565(Core::UInt16 color, Core::Int32* rgb) {
+        Core::Int32 r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+        rgb[0] = (r << 3) | (r >> 2);
+        rgb[1] = (g << 2) | (g >> 4);
+        rgb[2] = (b << 3) | (b >> 2);
+    }
+
+    void writeUInt16(Core::Byte* out, Core::UInt16 value) {
+        out[0] = value & 0xFF;
+        out[1] = (value >> 8) & 0xFF;
+    }
+}
+
+TextureCompressor::TextureCompressor() {
+
+}
+
+std::shared_ptr<CompressedImage> TextureCompressor::compress(const Core::StandardImage& image, Core::Bool blockCompress, Core::UInt32 maxLevels) {
+    std::shared_ptr<CompressedImage> compressed = std::make_shared<CompressedImage>();
+    compressed->width = image.getWidth();
+    compressed->height = image.getHeight();
+
+    Core::UInt32 pixelCount = compressed->width * compressed->height;
+    std::vector<Core::Byte> pixels(pixelCount * 4);
+    memcpy(pixels.data(), image.getImageData(), pixels.size());
+
+    compressed->format = blockCompress ? CompressedImage::Format::BC1 : CompressedImage::Format::RGBA8;
+    for (Core::UInt32 i = 0; blockCompress && i < pixelCount; i++) {
+        if (pixels[i * 4 + 3] != 255) {
+            compressed->format = CompressedImage::Format::BC3;
+            break;
+        }
+    }
+
+    Core::UInt32 width = compressed->width;
+    Core::UInt32 height = compressed->height;
+    while (true) {
+        compressed->levels.emplace_back();
+        CompressedImage::Level& level = compressed->levels.back();
+        level.width = width;
+        level.height = height;
+        std::vector<Core::Byte> blocks;
+        compressLevel(pixels, width, height, compressed->format, blocks);
+        level.data.assign(std::move(blocks));
+
+        if ((width == 1 && height == 1) || (maxLevels > 0 && compressed->levels.size() >= maxLevels)) break;
+
+        Core::UInt32 nextWidth = width > 1 ? width / 2 : 1;
+        Core::UInt32 nextHeight = height > 1 ? height / 2 : 1;
+        std::vector<Core::Byte> nextPixels;
+        downsample(pixels, width, height, nextPixels, nextWidth, nextHeight);
+        pixels.swap(nextPixels);
+        width = nextWidth;
+        height = nextHeight;
+    }
+    return compressed;
+}
+
+void TextureCompressor::downsample(const std::vector<Core::Byte>& src, Core::UInt32 srcWidth, Core::UInt32 srcHeight,
+                                   std::vector<Core::Byte>& dest, Core::UInt32 destWidth, Core::UInt32 destHeight) {
+    dest.resize(destWidth * destHeight * 4);
+    for (Core::UInt32 y = 0; y < destHeight; y++) {
+        Core::UInt32 y0 = std::min(y * 2, srcHeight - 1);
+        Core::UInt32 y1 = std::min(y * 2 + 1, srcHeight - 1);
+        for (Core::UInt32 x = 0; x < destWidth; x++) {
+            Core::UInt32 x0 = std::min(x * 2, srcWidth - 1);
+            Core::UInt32 x1 = std::min(x * 2 + 1, srcWidth - 1);
+            for (Core::UInt32 c = 0; c < 4; c++) {
+                Core::UInt32 sum = src[(y0 * srcWidth + x0) * 4 + c] + src[(y0 * srcWidth + x1) * 4 + c] +
+                                   src[(y1 * srcWidth + x0) * 4 + c] + src[(y1 * srcWidth + x1) * 4 + c];
+                dest[(y * destWidth + x) * 4 + c] = (Core::Byte)((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+void TextureCompressor::compressLevel(const std::vector<Core::Byte>& pixels, Core::UInt32 width, Core::UInt32 height,
+                                      CompressedImage::Format format, std::vector<Core::Byte>& out) {
+    if (format == CompressedImage::Format::RGBA8) {
+        out = pixels;
+        return;
+    }
+
+    Core::UInt32 blockSize = CompressedImage::getBlockSize(format);
+    Core::UInt32 blocksX = (width + 3) / 4;
+    Core::UInt32 blocksY = (height + 3) / 4;
+    out.resize(blocksX * blocksY * blockSize);
+
+    Core::Byte block[64];
+    for (Core::UInt32 by = 0; by < blocksY; by++) {
+        for (Core::UInt32 bx = 0; bx < blocksX; bx++) {
+            // edge blocks repeat the last row/column
+            for (Core::UInt32 py = 0; py < 4; py++) {
+                Core::UInt32 y = std::min(by * 4 + py, height - 1);
+                for (Core::UInt32 px = 0; px < 4; px++) {
+                    Core::UInt32 x = std::min(bx * 4 + px, width - 1);
+                    memcpy(&block[(py * 4 + px) * 4], &pixels[(y * width + x) * 4], 4);
+                }
+            }
+
+            Core::Byte* dest = &out[(by * blocksX + bx) * blockSize];
+            if (format == CompressedImage::Format::BC3) {
+                encodeAlphaBlock(block, dest);
+                dest += 8;
+            }
+            encodeColorBlock(block, dest);
+        }
+    }
+}
+
+void TextureCompressor::encodeColorBlock(const Core::Byte block[64], Core::Byte* out) {
+    Core::Int32 minColor[3] = {255, 255, 255};
+    Core::Int32 maxColor[3] = {0, 0, 0};
+    Core::Int32 mean[3] = {0, 0, 0};
+    for (Core::UInt32 i = 0; i < 16; i++) {
+        for (Core::UInt32 c = 0; c < 3; c++) {
+            Core::Int32 value = block[i * 4 + c];
+            minColor[c] = std::min(minColor[c], value);
+            maxColor[c] = std::max(maxColor[c], value);
+            mean[c] += value;
+        }
+    }
+
+    // pick the box diagonal that follows the colors: flip green/blue when they fall as red rises
+    Core::Int32 covarianceRG = 0, covarianceRB = 0;
+    for (Core::UInt32 i = 0; i < 16; i++) {
+        Core::Int32 r = block[i * 4] * 16 - mean[0];
+        covarianceRG += r * (block[i * 4 + 1] * 16 - mean[1]);
+        covarianceRB += r * (block[i * 4 + 2] * 16 - mean[2]);
+    }
+    if (covarianceRG < 0) std::swap(minColor[1], maxColor[1]);
+    if (covarianceRB < 0) std::swap(minColor[2], maxColor[2]);
+
+    // inset the endpoints a little so the interpolated colors land inside the block's range
+    for (Core::UInt32 c = 0; c < 3; c++) {
+        Core::Int32 inset = (maxColor[c] - minColor[c]) / 16;
+        maxColor[c] -= inset;
+        minColor[c] += inset;
+    }
+
+    Core::UInt16 color0 = packColor565(maxColor[0], maxColor[1], maxColor[2]);
+    Core::UInt16 color1 = packColor565(minColor[0], minColor[1], minColor[2]);
+    // color0 > color1 selects the four-color mode
+    if (color0 < color1) std::swap(color0, color1);
+
+    Core::UInt32 indices = 0;
+    if (color0 != color1) {
+        Core::Int32 palette[4][3];
+        unpackColor565(color0, palette[0]);
+        unpackColor565(color1, palette[1]);
+        for (Core::UInt32 c = 0; c < 3; c++) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        for (Core::UInt32 i = 0; i < 16; i++) {
+            Core::UInt32 best = 0;
+            Core::Int32 bestDistance = -1;
+            for (Core::UInt32 p = 0; p < 4; p++) {
+                Core::Int32 dr = block[i * 4] - palette[p][0];
+                Core::Int32 dg = block[i * 4 + 1] - palette[p][1];
+                Core::Int32 db = block[i * 4 + 2] - palette[p][2];
+                Core::Int32 distance = dr * dr + dg * dg + db * db;
+                if (bestDistance < 0 || distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= best << (i * 2);
+        }
+    }
+
+    writeUInt16(out, color0);
+    writeUInt16(out + 2, color1);
+    writeUInt16(out + 4, indices & 0xFFFF);
+    writeUInt16(out + 6, indices >> 16);
+}
+
+void TextureCompressor::encodeAlphaBlock(const Core::Byte block[64], Core::Byte* out) {
+    Core::Int32 minAlpha = 255, maxAlpha = 0;
+    for (Core::UInt32 i = 0; i < 16; i++) {
+        minAlpha = std::min(minAlpha, (Core::Int32)block[i * 4 + 3]);
+        maxAlpha = std::max(maxAlpha, (Core::Int32)block[i * 4 + 3]);
+    }
+
+    out[0] = (Core::Byte)maxAlpha;
+    out[1] = (Core::Byte)minAlpha;
+    Core::UInt64 indices = 0;
+    if (maxAlpha != minAlpha) {
+        // alpha0 > alpha1 selects the eight-value mode
+        Core::Int32 palette[8];
+        palette[0] = maxAlpha;
+        palette[1] = minAlpha;
+        for (Core::UInt32 p = 1; p < 7; p++) {
+            palette[p + 1] = ((7 - p) * maxAlpha + p * minAlpha) / 7;
+        }
+
+        for (Core::UInt32 i = 0; i < 16; i++) {
+            Core::UInt64 best = 0;
+            Core::Int32 bestDistance = 256;
+            for (Core::UInt32 p = 0; p < 8; p++) {
+                Core::Int32 distance = std::abs(block[i * 4 + 3] - palette[p]);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= best << (i * 3);
+        }
+    }
+
+    for (Core::UInt32 i = 0; i < 6; i++) {
+        out[2 + i] = (indices >> (i * 8)) & 0xFF;
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <memory>
+
+#include "Core/image/StandardImage.h"
+
+#include "CompressedImage.h"
+
+// CPU BC1/BC3 encoder. Builds the mip chain with a box filter and encodes each level
+// with a bounding-box endpoint fit, which is good enough for albedo maps and atlases.
+// Without blockCompress the chain is kept as RGBA8.
+class TextureCompressor {
+public:
+    TextureCompressor();
+
+    // maxLevels == 0 builds the full chain down to 1x1
+    static std::shared_ptr<CompressedImage> compress(const Core::StandardImage& image, Core::Bool blockCompress, Core::UInt32 maxLevels = 0);
+
+private:
+    static void downsample(const std::vector<Core::Byte>& src, Core::UInt32 srcWidth, Core::UInt32 srcHeight,
+                           std::vector<Core::Byte>& dest, Core::UInt32 destWidth, Core::UInt32 destHeight);
+    static void compressLevel(const std::vector<Core::Byte>& pixels, Core::UInt32 width, Core::UInt32 height,
+                              CompressedImage::Format format, std::vector<Core::Byte>& out);
+    static void encodeColorBlock(const Core::Byte block[64], Core::Byte* out);
+    static void encodeAlphaBlock(const Core::Byte block[64], Core::Byte* out);
+};
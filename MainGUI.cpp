@@ -21,6 +21,7 @@
 #include <QTreeWidget>
 #include <QHeaderView>
 #include <QCheckBox>
+#include <QComboBox>
 
 #include "Core/math/Quaternion.h"
 #include "Core/scene/Scene.h"
@@ -28,6 +29,7 @@
 #include "Core/render/MeshRenderer.h"
 
 const float MainGUI::OBJECT_PROPERTY_GUI_UPDATE_EPSILON = 0.000005f;
+const QString MainGUI::MODEL_PATH_SEPARATOR = ";";
 
 MainGUI::MainGUI(MainWindow *mw): modelerApp(nullptr), qtApp(nullptr), mainWindow(mw), sceneObjectTree(nullptr),
     modelImportScaleEdit(nullptr), modelImportSmoothingThresholdEdit(nullptr), modelImportZUpCheckBox(nullptr), modelImportphysicalMaterialCheckBox(nullptr) {
@@ -305,8 +307,17 @@ QHBoxLayout* MainGUI::buildSceneToolsLayout() {
     rotationButton->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
     rotationButton->setFixedSize(rotationPixmap.rect().size());
 
+    QComboBox *sceneComboBox = new QComboBox(this);
+    sceneComboBox->addItem("Sunny sky", (int)ModelerApp::SceneID::SunnySky);
+    sceneComboBox->addItem("Sunrise", (int)ModelerApp::SceneID::Sunrise);
+    sceneComboBox->addItem("Sunset", (int)ModelerApp::SceneID::Sunset);
+    sceneComboBox->addItem("Moonlit night", (int)ModelerApp::SceneID::MoonlitNight);
+    sceneComboBox->setCurrentIndex(sceneComboBox->findData((int)ModelerApp::SceneID::MoonlitNight));
+    connect(sceneComboBox, SIGNAL(activated(int)), SLOT(sceneSelected(int)));
+
     sceneToolsLayout->addWidget(translationButton);
     sceneToolsLayout->addWidget(rotationButton);
+    sceneToolsLayout->addWidget(sceneComboBox);
     return sceneToolsLayout;
 
 }
@@ -355,6 +366,7 @@ void MainGUI::updateSelectedSceneObjectsPropertiesFromGUI() {
     if (selectedObjects.size() == 1) {
         Core::WeakPointer<Core::Object3D> object = selectedObjects[0];
         object->getTransform().getLocalMatrix().compose(this->selectedObjectTranslation, this->selectedObjectEuler, this->selectedObjectScale);
+        this->modelerApp->requestRedraw();
     }
 }
 
@@ -448,36 +460,52 @@ void MainGUI::browseForModel() {
     }
 
     if (selectedFiles.size() > 0) {
-        this->modelNameEdit->setText(selectedFiles.at(0));
+        this->modelNameEdit->setText(selectedFiles.join(MODEL_PATH_SEPARATOR));
     }
 }
 
 void MainGUI::loadModel() {
-    QString nameQStr = this->modelNameEdit->text();
-    float scale = this->modelImportScale;
-    float smoothingThreshold = this->modelImportSmoothingThreshold;
-    this->modelerApp->loadModel(nameQStr.toStdString(), scale, smoothingThreshold, this->modelImportZUp, true, true, this->modelImportPhysicalMaterial, [this](Core::WeakPointer<Core::Object3D> rootObject){
-       Core::WeakPointer<Core::Scene> scene = this->modelerApp->getEngine()->getActiveScene();
-       scene->visitScene(rootObject, [this, rootObject](Core::WeakPointer<Core::Object3D> obj){
-           Core::WeakPointer<Core::BaseRenderableContainer> baseRenderableContainer = obj->getBaseRenderableContainer();
-           if (baseRenderableContainer.isValid()) {
-               Core::WeakPointer<Core::MeshContainer> meshContainer = Core::WeakPointer<Core::BaseRenderableContainer>::dynamicPointerCast<Core::MeshContainer>(baseRenderableContainer);
-               if (meshContainer) {
-                   Core::WeakPointer<Core::Object3DRenderer<Core::Mesh>> objectRenderer = Core::WeakPointer<Core::BaseObject3DRenderer>::dynamicPointerCast<Core::Object3DRenderer<Core::Mesh>>(obj->getBaseRenderer());
-                   if (objectRenderer) {
-                       Core::WeakPointer<Core::MeshRenderer> meshRenderer = Core::WeakPointer<Core::Object3DRenderer<Core::Mesh>>::dynamicPointerCast<Core::MeshRenderer>(objectRenderer);
-                       if (meshRenderer) {
-                           Core::WeakPointer<Core::Material> renderMaterial = meshRenderer->getMaterial();
-                           Core::WeakPointer<Core::StandardPhysicalMaterial> physicalMaterial = Core::WeakPointer<Core::Material>::dynamicPointerCast<Core::StandardPhysicalMaterial>(renderMaterial);
-                           if (physicalMaterial) {
-                               physicalMaterial->setMetallic(this->modelImportPhysicalMetallic);
-                               physicalMaterial->setRoughness(this->modelImportPhysicalRoughness);
-                           }
-                       }
-                   }
-               }
-           }
-       });
+    QStringList paths = this->modelNameEdit->text().split(MODEL_PATH_SEPARATOR, Qt::SkipEmptyParts);
+    std::vector<ModelerApp::ModelLoadRequest> requests;
+    for (const QString& path : paths) {
+        ModelerApp::ModelLoadRequest request;
+        request.path = path.trimmed().toStdString();
+        request.scale = this->modelImportScale;
+        // the edit box is in degrees
+        request.smoothingThreshold = this->modelImportSmoothingThreshold * Core::Math::DegreesToRads;
+        request.zUp = this->modelImportZUp;
+        request.preserveFBXPivots = true;
+        request.usePhysicalMaterial = true;
+        request.castShadows = this->modelImportPhysicalMaterial;
+        request.callback = [this](Core::WeakPointer<Core::Object3D> rootObject) {
+            this->applyImportMaterialSettings(rootObject);
+        };
+        requests.push_back(request);
+    }
+    this->modelerApp->loadModels(requests, nullptr);
+}
+
+void MainGUI::applyImportMaterialSettings(Core::WeakPointer<Core::Object3D> rootObject) {
+    Core::WeakPointer<Core::Scene> scene = this->modelerApp->getEngine()->getActiveScene();
+    scene->visitScene(rootObject, [this, rootObject](Core::WeakPointer<Core::Object3D> obj){
+        Core::WeakPointer<Core::BaseRenderableContainer> baseRenderableContainer = obj->getBaseRenderableContainer();
+        if (baseRenderableContainer.isValid()) {
+            Core::WeakPointer<Core::MeshContainer> meshContainer = Core::WeakPointer<Core::BaseRenderableContainer>::dynamicPointerCast<Core::MeshContainer>(baseRenderableContainer);
+            if (meshContainer) {
+                Core::WeakPointer<Core::Object3DRenderer<Core::Mesh>> objectRenderer = Core::WeakPointer<Core::BaseObject3DRenderer>::dynamicPointerCast<Core::Object3DRenderer<Core::Mesh>>(obj->getBaseRenderer());
+                if (objectRenderer) {
+                    Core::WeakPointer<Core::MeshRenderer> meshRenderer = Core::WeakPointer<Core::Object3DRenderer<Core::Mesh>>::dynamicPointerCast<Core::MeshRenderer>(objectRenderer);
+                    if (meshRenderer) {
+                        Core::WeakPointer<Core::Material> renderMaterial = meshRenderer->getMaterial();
+                        Core::WeakPointer<Core::StandardPhysicalMaterial> physicalMaterial = Core::WeakPointer<Core::Material>::dynamicPointerCast<Core::StandardPhysicalMaterial>(renderMaterial);
+                        if (physicalMaterial) {
+                            physicalMaterial->setMetallic(this->modelImportPhysicalMetallic);
+                            physicalMaterial->setRoughness(this->modelImportPhysicalRoughness);
+                        }
+                    }
+                }
+            }
+        }
     });
 }
 
@@ -667,3 +695,9 @@ void MainGUI::setTransformModeTranslation() {
 void MainGUI::setTransformModeRotation() {
     this->modelerApp->setTransformModeRotation();
 }
+
+void MainGUI::sceneSelected(int index) {
+    QComboBox* sceneComboBox = static_cast<QComboBox*>(this->sender());
+    ModelerApp::SceneID scene = (ModelerApp::SceneID)sceneComboBox->itemData(index).toInt();
+    if (scene != this->modelerApp->getCurrentScene()) this->modelerApp->switchScene(scene);
+}
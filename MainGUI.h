@@ -53,10 +53,13 @@ protected slots:
     void updateModelImportPhysicalSettingsVisibility(bool checked);
     void setTransformModeTranslation();
     void setTransformModeRotation();
+    void sceneSelected(int index);
 
 private:
 
     static const float OBJECT_PROPERTY_GUI_UPDATE_EPSILON;
+    // browsing for several models lists them all in the model name field, separated by this
+    static const QString MODEL_PATH_SEPARATOR;
 
     class SceneTreeWidgetItem: public QTreeWidgetItem {
     public:
@@ -79,6 +82,7 @@ private:
     void refreshSceneTree();
     void expandAllAbove(SceneTreeWidgetItem* item);
     void buildModelImportSettingsDialog();
+    void applyImportMaterialSettings(Core::WeakPointer<Core::Object3D> rootObject);
 
     ModelerApp* modelerApp;
     QApplication* qtApp;
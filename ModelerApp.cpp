@@ -1,3 +1,9 @@
+#include <atomic>
+#include <unordered_set>
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+
 #include "ModelerApp.h"
 #include "RenderWindow.h"
 #include "SceneUtils.h"
@@ -6,7 +12,11 @@
 #include "Scene/SunriseScene.h"
 #include "Scene/SunsetScene.h"
 #include "Scene/MoonlitNightScene.h"
+#include "Util/DevILLock.h"
 #include "Util/FileUtil.h"
+#include "Util/StartupTimeline.h"
+#include "Import/ModelImporter.h"
+#include "Import/ModelBuilder.h"
 
 #include "Core/util/Time.h"
 #include "Core/scene/Scene.h"
@@ -70,10 +80,35 @@ void ModelerApp::setRenderWindow(RenderWindow* renderWindow) {
         this->renderWindow = renderWindow;
         RenderWindow::LifeCycleEventCallback onRenderWindowInit = [this](RenderWindow* renderWindow) {
             this->engine = renderWindow->getEngine();
-            this->coreSync = std::make_shared<CoreSync>();
+            this->frameBudget = std::make_shared<FrameBudget>();
+            this->frameBudget->setBudgetMs(this->frameBudgetMs);
+            this->frameBudget->reset();
+            this->coreSync = std::make_shared<CoreSync>(this->frameBudget);
+            this->streamingLoader = std::make_shared<StreamingLoader>(this->frameBudget);
+            this->textureLoader = std::make_shared<LazyTextureLoader>(this->frameBudget);
+            this->animationCache = std::make_shared<AnimationCache>(this->coreSync);
+            this->modelCache.rebuildStale();
             this->engineReady(engine);
 
+            // on-demand rendering keeps drawing while anything is still arriving or moving by itself; input,
+            // selection and GUI edits ask for frames directly
+            this->coreSync->onQueued([this]() {
+                this->renderWindow->requestFrames();
+            });
+            renderWindow->setActivityCheck([this]() {
+                return this->sceneSwitchPending || this->coreSync->getQueueDepth() > 0 || this->streamingLoader->getOutstandingCount() > 0 ||
+                       this->textureLoader->getOutstandingCount() > 0 || (this->modelerScene && this->modelerScene->isAnimating());
+            });
+
+            renderWindow->setHoverCheck([this]() {
+                return this->gizmoVisible.load();
+            });
+
             std::shared_ptr<MouseAdapter> mouseAdapter = std::make_shared<MouseAdapter>();
+            this->mouseAdapter = mouseAdapter;
+            mouseAdapter->onBacklog([this]() {
+                this->renderWindow->requestFrames();
+            });
             this->renderWindow->setMouseAdapter(mouseAdapter);
             mouseAdapter->onMouseButtonPressed(std::bind(&ModelerApp::mouseButton, this, std::placeholders::_1,  std::placeholders::_2,  std::placeholders::_3, std::placeholders::_4));
             mouseAdapter->onMouseButtonReleased(std::bind(&ModelerApp::mouseButton, this, std::placeholders::_1,  std::placeholders::_2,  std::placeholders::_3, std::placeholders::_4));
@@ -87,70 +122,260 @@ void ModelerApp::setRenderWindow(RenderWindow* renderWindow) {
     }
 }
 
+void ModelerApp::setFrameBudgetMs(Core::Real frameBudgetMs) {
+    this->frameBudgetMs = frameBudgetMs;
+    if (this->frameBudget) this->frameBudget->setBudgetMs(frameBudgetMs);
+}
+
 void ModelerApp::loadModel(const std::string& path, float scale, float smoothingThreshold, bool zUp, bool preserveFBXPivots, bool usePhysicalMaterial, bool castShadows, ModelerAppLoadModelCallback callback) {
+    ModelLoadRequest request = buildLoadRequest(path, scale, smoothingThreshold, zUp, preserveFBXPivots, usePhysicalMaterial, castShadows, callback);
+    this->requestModelLoad(request, false, Core::Point3r());
+}
+
+void ModelerApp::loadModel(const std::string& path, float scale, float smoothingThreshold, bool zUp, bool preserveFBXPivots, bool usePhysicalMaterial, bool castShadows, ModelerAppLoadModelCallback callback,
+                           const Core::Point3r& streamingPosition) {
+    ModelLoadRequest request = buildLoadRequest(path, scale, smoothingThreshold, zUp, preserveFBXPivots, usePhysicalMaterial, castShadows, callback);
+    this->requestModelLoad(request, true, streamingPosition);
+}
+
+void ModelerApp::loadModel(const ModelLoadRequest& request, const Core::Point3r& streamingPosition) {
+    this->requestModelLoad(request, true, streamingPosition);
+}
+
+void ModelerApp::requestModelLoad(const ModelLoadRequest& request, bool positioned, const Core::Point3r& streamingPosition) {
    if (this->engineIsReady) {
-        std::string sPath = path;
-        sPath = FileUtil::removePrefix(sPath, "file://");
-        std::string abbrevName = FileUtil::extractFileNameFromPath(sPath, true);
-
-        if (smoothingThreshold < 0 ) smoothingThreshold = 0;
-        if (smoothingThreshold >= 90) smoothingThreshold = 90;
-
-        CoreSync::Runnable runnable = [this, sPath, scale, smoothingThreshold, zUp, preserveFBXPivots, usePhysicalMaterial, castShadows, abbrevName, callback](Core::WeakPointer<Core::Engine> engine) {
-           Core::ModelLoader& modelLoader = engine->getModelLoader();
-           modelLoader.setFallbackTexturePath("assets/textures/");
-           Core::WeakPointer<Core::Object3D> rootObject = modelLoader.loadModel(sPath, scale, smoothingThreshold, castShadows, true, preserveFBXPivots, usePhysicalMaterial);
-
-           Core::WeakPointer<Core::Object3D> newRoot = engine->createObject3D();
-           newRoot->getTransform().getLocalMatrix().copy(rootObject->getTransform().getLocalMatrix());
-           newRoot->addChild(rootObject);
-           rootObject->getTransform().getLocalMatrix().setIdentity();
-           rootObject = newRoot;
-
-           rootObject->setName(abbrevName);
-           this->coreScene.addObjectToScene(rootObject);
-           Core::WeakPointer<Core::Scene> scene = engine->getActiveScene();
-           scene->visitScene(rootObject, [this, rootObject](Core::WeakPointer<Core::Object3D> obj){
-               Core::WeakPointer<Core::BaseRenderableContainer> baseRenderableContainer = obj->getBaseRenderableContainer();
-               if (baseRenderableContainer.isValid()) {
-                   Core::WeakPointer<Core::MeshContainer> meshContainer =
-                           Core::WeakPointer<Core::BaseRenderableContainer>::dynamicPointerCast<Core::MeshContainer>(baseRenderableContainer);
-                   if (meshContainer) {
-                       for (Core::UInt32 i = 0; i < meshContainer->getBaseRenderableCount(); i++) {
-                           Core::WeakPointer<Core::Mesh> mesh = meshContainer->getRenderable(i);
-                           this->coreScene.addObjectToSceneRaycaster(obj, mesh);
-                       }
-                   }
-               }
-           });
-
-           if (zUp) {
-               rootObject->getTransform().rotate(1.0f, 0.0f, 0.0f, -Core::Math::PI / 2.0);
-           }
-
-           callback(rootObject);
-       };
-       this->coreSync->run(runnable);
+        ImportSettings settings = buildImportSettings(request);
+        bool zUp = request.zUp;
+        ModelerAppLoadModelCallback callback = request.callback;
+        std::string abbrevName = FileUtil::extractFileNameFromPath(settings.path, true);
+        // the callback belongs to the scene that asked for the model, so the load is cancelled with the rest of
+        // that scene's tasks: one that hasn't started skips its parse, one that has still warms the cache but isn't built
+        CoreSync::Future future = this->coreSync->track(getSceneTag(this->sceneGeneration));
+
+        StreamingLoader::Starter starter;
+        if (!settings.usePhysicalMaterial) {
+            // legacy materials are only produced by Core's own loader, which runs entirely on the render thread
+            starter = [this, settings, zUp, abbrevName, callback, future](StreamingLoader::ReadyCallback ready) {
+                ready([this, settings, zUp, abbrevName, callback, future](Core::WeakPointer<Core::Engine> engine) mutable {
+                    if (!future.claim()) return;
+                    Core::WeakPointer<Core::Object3D> rootObject = this->loadModelWithModelLoader(engine, settings);
+                    this->addLoadedModelToScene(engine, rootObject, abbrevName, zUp, callback);
+                    future.finish();
+                });
+            };
+        } else {
+            // parse on a worker (once per file + settings), build GPU resources and the scene graph on the render thread; textures fill in afterwards
+            starter = [this, settings, zUp, abbrevName, callback, future](StreamingLoader::ReadyCallback ready) {
+                if (future.isCancelled()) {
+                    ready([](Core::WeakPointer<Core::Engine> engine) {});
+                    return;
+                }
+                this->modelCache.load(settings, [this, settings, zUp, abbrevName, callback, future, ready](std::shared_ptr<ModelDescription> description) mutable {
+                    if (!description) {
+                        std::cout << "ModelerApp::loadModel() -> Failed to load '" << settings.path << "'" << std::endl;
+                        if (future.claim()) future.finish(true);
+                        ready([](Core::WeakPointer<Core::Engine> engine) {});
+                        return;
+                    }
+
+                    ready([this, description, settings, zUp, abbrevName, callback, future](Core::WeakPointer<Core::Engine> engine) mutable {
+                        if (!future.claim()) return;
+                        Core::WeakPointer<Core::Object3D> rootObject = this->instantiateModel(engine, settings, description);
+                        this->addLoadedModelToScene(engine, rootObject, abbrevName, zUp, callback);
+                        future.finish();
+                    });
+                });
+            };
+        }
+
+        if (positioned) this->streamingLoader->request(streamingPosition, starter);
+        else this->streamingLoader->request(starter);
    }
 }
 
+void ModelerApp::loadModels(const std::vector<ModelLoadRequest>& requests, ModelerAppLoadModelsCallback callback) {
+    if (!this->engineIsReady || requests.size() == 0) return;
+
+    class Batch {
+    public:
+        std::vector<ModelLoadRequest> requests;
+        std::vector<ImportSettings> settings;
+        std::vector<std::shared_ptr<ModelDescription>> descriptions;
+        std::atomic<Core::UInt32> remaining;
+    };
+
+    std::shared_ptr<Batch> batch = std::make_shared<Batch>();
+    batch->requests = requests;
+    batch->descriptions.resize(requests.size());
+    batch->remaining = (Core::UInt32)requests.size();
+    for (const ModelLoadRequest& request : requests) {
+        batch->settings.push_back(buildImportSettings(request));
+    }
+
+    // the whole batch is a single streaming load: every file parses on the pool at once, and
+    // the render-thread half runs as one finalizer so the scene changes in a single step;
+    // like single loads it is cancelled along with the scene that asked for it
+    CoreSync::Future future = this->coreSync->track(getSceneTag(this->sceneGeneration));
+    StreamingLoader::Starter starter = [this, batch, callback, future](StreamingLoader::ReadyCallback ready) {
+        if (future.isCancelled()) {
+            ready([](Core::WeakPointer<Core::Engine> engine) {});
+            return;
+        }
+        StreamingLoader::Finalizer splice = [this, batch, callback, future](Core::WeakPointer<Core::Engine> engine) mutable {
+            if (!future.claim()) return;
+            std::vector<Core::WeakPointer<Core::Object3D>> rootObjects;
+            for (Core::UInt32 i = 0; i < batch->requests.size(); i++) {
+                const ModelLoadRequest& request = batch->requests[i];
+                const ImportSettings& settings = batch->settings[i];
+                Core::WeakPointer<Core::Object3D> rootObject;
+                if (!settings.usePhysicalMaterial) {
+                    rootObject = this->loadModelWithModelLoader(engine, settings);
+                } else if (batch->descriptions[i]) {
+                    rootObject = this->instantiateModel(engine, settings, batch->descriptions[i]);
+                }
+                if (!rootObject.isValid()) {
+                    std::cout << "ModelerApp::loadModels() -> Failed to load '" << settings.path << "'" << std::endl;
+                    continue;
+                }
+
+                std::string abbrevName = FileUtil::extractFileNameFromPath(settings.path, true);
+                this->addLoadedModelToScene(engine, rootObject, abbrevName, request.zUp, [&rootObjects](Core::WeakPointer<Core::Object3D> newRoot) {
+                    rootObjects.push_back(newRoot);
+                });
+                if (request.callback) request.callback(rootObjects.back());
+            }
+            if (callback) callback(rootObjects);
+            future.finish();
+        };
+
+        for (Core::UInt32 i = 0; i < batch->requests.size(); i++) {
+            if (!batch->settings[i].usePhysicalMaterial) {
+                if (--batch->remaining == 0) ready(splice);
+                continue;
+            }
+            this->modelCache.load(batch->settings[i], [batch, i, ready, splice](std::shared_ptr<ModelDescription> description) {
+                batch->descriptions[i] = description;
+                if (--batch->remaining == 0) ready(splice);
+            });
+        }
+    };
+    this->streamingLoader->request(starter);
+}
+
+Core::UInt32 ModelerApp::prefetchModels(const std::vector<ModelLoadRequest>& requests) {
+    std::unordered_set<std::string> keys;
+    for (const ModelLoadRequest& request : requests) {
+        // legacy materials come from Core's loader on the render thread, there's nothing to parse ahead of time
+        if (!request.usePhysicalMaterial) continue;
+        ImportSettings settings = buildImportSettings(request);
+        if (!keys.insert(ModelCache::getKey(settings)).second) continue;
+        this->modelCache.load(settings, [](std::shared_ptr<ModelDescription> description) {});
+    }
+    return keys.size();
+}
+
 void ModelerApp::loadAnimation(const std::string& path, bool addLoopPadding, bool preserveFBXPivots, ModelerAppLoadAnimationCallback callback) {
     if (this->engineIsReady) {
          std::string sPath = path;
          sPath = FileUtil::removePrefix(sPath, "file://");
-         CoreSync::Runnable runnable = [this, sPath, addLoopPadding, preserveFBXPivots, callback](Core::WeakPointer<Core::Engine> engine) {
-            Core::ModelLoader& modelLoader = engine->getModelLoader();
-            Core::WeakPointer<Core::Animation> animation = modelLoader.loadAnimation(sPath, addLoopPadding, preserveFBXPivots);
-            callback(animation);
-        };
-        this->coreSync->run(runnable);
+         Core::UInt32 generation = this->sceneGeneration;
+         this->animationCache->load(sPath, addLoopPadding, preserveFBXPivots, [this, generation, callback](Core::WeakPointer<Core::Animation> animation) {
+             if (generation == this->sceneGeneration) callback(animation);
+         }, getSceneTag(generation));
+    }
+}
+
+ModelerApp::ModelLoadRequest ModelerApp::buildLoadRequest(const std::string& path, float scale, float smoothingThreshold, bool zUp, bool preserveFBXPivots,
+                                                          bool usePhysicalMaterial, bool castShadows, ModelerAppLoadModelCallback callback) {
+    ModelLoadRequest request;
+    request.path = path;
+    request.scale = scale;
+    request.smoothingThreshold = smoothingThreshold;
+    request.zUp = zUp;
+    request.preserveFBXPivots = preserveFBXPivots;
+    request.usePhysicalMaterial = usePhysicalMaterial;
+    request.castShadows = castShadows;
+    request.callback = callback;
+    return request;
+}
+
+ImportSettings ModelerApp::buildImportSettings(const ModelLoadRequest& request) {
+    float smoothingThreshold = request.smoothingThreshold;
+    if (smoothingThreshold < 0 ) smoothingThreshold = 0;
+    if (smoothingThreshold >= Core::Math::PI / 2.0f) smoothingThreshold = Core::Math::PI / 2.0f;
+
+    ImportSettings settings;
+    settings.path = FileUtil::removePrefix(request.path, "file://");
+    settings.scale = request.scale;
+    settings.smoothingThreshold = smoothingThreshold;
+    settings.castShadows = request.castShadows;
+    settings.preserveFBXPivots = request.preserveFBXPivots;
+    settings.usePhysicalMaterial = request.usePhysicalMaterial;
+    settings.optimizeMeshes = request.optimizeMeshes;
+    settings.blended = request.blended;
+    return settings;
+}
+
+Core::WeakPointer<Core::Object3D> ModelerApp::instantiateModel(Core::WeakPointer<Core::Engine> engine, const ImportSettings& settings, std::shared_ptr<ModelDescription> description) {
+    StartupTimeline::Scope timelineScope("ModelerApp::instantiateModel " + settings.path);
+    // skinned meshes still need Core's loader for bones and animation bindings
+    if (description->hasSkinnedMeshes) {
+        return this->loadModelWithModelLoader(engine, settings);
     }
+    std::shared_ptr<ModelResources> resources = this->modelCache.getResources(engine, description, *this->textureLoader);
+    return ModelBuilder::instantiate(engine, *description, *resources, settings.castShadows);
+}
+
+Core::WeakPointer<Core::Object3D> ModelerApp::loadModelWithModelLoader(Core::WeakPointer<Core::Engine> engine, const ImportSettings& settings) {
+    StartupTimeline::Scope timelineScope("ModelerApp::loadModelWithModelLoader " + settings.path);
+    StartupTimeline::addBytesRead(QFileInfo(QString::fromStdString(settings.path)).size());
+    Core::ModelLoader& modelLoader = engine->getModelLoader();
+    modelLoader.setFallbackTexturePath(ModelImporter::FallbackTexturePath);
+    // Core decodes the model's textures with DevIL
+    DevILLock devILLock;
+    return modelLoader.loadModel(settings.path, settings.scale, settings.smoothingThreshold, settings.castShadows, true, settings.preserveFBXPivots, settings.usePhysicalMaterial);
+}
+
+void ModelerApp::addLoadedModelToScene(Core::WeakPointer<Core::Engine> engine, Core::WeakPointer<Core::Object3D> rootObject, const std::string& name,
+                                       bool zUp, ModelerAppLoadModelCallback callback) {
+    Core::WeakPointer<Core::Object3D> newRoot = engine->createObject3D();
+    newRoot->getTransform().getLocalMatrix().copy(rootObject->getTransform().getLocalMatrix());
+    newRoot->addChild(rootObject);
+    rootObject->getTransform().getLocalMatrix().setIdentity();
+    rootObject = newRoot;
+
+    rootObject->setName(name);
+    this->coreScene.addObjectToScene(rootObject);
+    Core::WeakPointer<Core::Scene> scene = engine->getActiveScene();
+    scene->visitScene(rootObject, [this, rootObject](Core::WeakPointer<Core::Object3D> obj){
+        Core::WeakPointer<Core::BaseRenderableContainer> baseRenderableContainer = obj->getBaseRenderableContainer();
+        if (baseRenderableContainer.isValid()) {
+            Core::WeakPointer<Core::MeshContainer> meshContainer =
+                    Core::WeakPointer<Core::BaseRenderableContainer>::dynamicPointerCast<Core::MeshContainer>(baseRenderableContainer);
+            if (meshContainer) {
+                for (Core::UInt32 i = 0; i < meshContainer->getBaseRenderableCount(); i++) {
+                    Core::WeakPointer<Core::Mesh> mesh = meshContainer->getRenderable(i);
+                    this->coreScene.addObjectToSceneRaycaster(obj, mesh);
+                }
+            }
+        }
+    });
+
+    if (zUp) {
+        rootObject->getTransform().rotate(1.0f, 0.0f, 0.0f, -Core::Math::PI / 2.0);
+    }
+
+    callback(rootObject);
 }
 
 CoreScene& ModelerApp::getCoreScene() {
     return this->coreScene;
 }
 
+ModelCache& ModelerApp::getModelCache() {
+    return this->modelCache;
+}
+
 void ModelerApp::onUpdate(ModelerAppLifecycleEventCallback callback) {
     QMutexLocker ml(&this->onUpdateMutex);
     this->onUpdates.push_back(callback);
@@ -166,6 +391,7 @@ bool ModelerApp::isSceneObjectHidden(Core::WeakPointer<Core::Object3D> object) {
 
 void ModelerApp::setSceneObjectHidden(Core::WeakPointer<Core::Object3D> object, bool hidden) {
     this->hiddenSceneObjects[object->getObjectID()] = hidden;
+    this->requestRedraw();
 }
 
 Core::WeakPointer<Core::Camera> ModelerApp::getRenderCamera() {
@@ -193,13 +419,32 @@ Core::WeakPointer<Core::Engine> ModelerApp::getEngine() {
 
 void ModelerApp::setTransformModeTranslation() {
     this->transformWidget.activateTranslationMode();
+    this->requestRedraw();
 }
 
 void ModelerApp::setTransformModeRotation() {
     this->transformWidget.activateRotationMode();
+    this->requestRedraw();
+}
+
+void ModelerApp::switchScene(SceneID scene) {
+    if (!this->engineIsReady) return;
+    // the old scene's objects may be mid-render right now, so the swap waits for the top of the next update
+    this->pendingScene = scene;
+    this->sceneSwitchPending = true;
+    this->requestRedraw();
+}
+
+void ModelerApp::requestRedraw() {
+    if (this->renderWindow) this->renderWindow->requestFrames(RenderWindow::SettleFrameCount);
+}
+
+ModelerApp::SceneID ModelerApp::getCurrentScene() const {
+    return this->currentScene;
 }
 
 void ModelerApp::engineReady(Core::WeakPointer<Core::Engine> engine) {
+    StartupTimeline::Scope timelineScope("ModelerApp::engineReady");
 
     this->engineIsReady = true;
     this->scene = engine->createScene();
@@ -208,6 +453,11 @@ void ModelerApp::engineReady(Core::WeakPointer<Core::Engine> engine) {
     this->coreScene.setSceneRoot(this->scene->getRoot());
     engine->getGraphicsSystem()->setClearColor(Core::Color(0, 0, 0, 0));
     this->setupRenderCamera();
+    this->persistentSceneObjects.clear();
+    Core::WeakPointer<Core::Object3D> sceneRoot = this->scene->getRoot();
+    for (Core::UInt32 i = 0; i < sceneRoot->childCount(); i++) {
+        this->persistentSceneObjects.push_back(sceneRoot->getChild(i));
+    }
 
     this->loadScene(SceneID::MoonlitNight);
 
@@ -218,12 +468,16 @@ void ModelerApp::engineReady(Core::WeakPointer<Core::Engine> engine) {
         if (selectedObject) {
             this->transformWidget.addTargetObject(selectedObject);
         }
+        this->gizmoVisible = this->transformWidget.getTargetObjectCount() > 0;
+        this->requestRedraw();
     });
 
     this->coreScene.onSelectedObjectRemoved([this](Core::WeakPointer<Core::Object3D> deselectedObject){
         if (deselectedObject) {
             this->transformWidget.removeTargetObject(deselectedObject);
         }
+        this->gizmoVisible = this->transformWidget.getTargetObjectCount() > 0;
+        this->requestRedraw();
     });
 
     engine->onPreRender([this]() {
@@ -235,9 +489,37 @@ void ModelerApp::engineReady(Core::WeakPointer<Core::Engine> engine) {
     }, true);
 
     engine->onUpdate([this]() {
+        // input queued since the last frame is handled here, so raycasts and transform edits happen inside the frame
+        if (this->mouseAdapter) this->mouseAdapter->drainQueuedEvents();
         auto vp = this->engine->getGraphicsSystem()->getCurrentRenderTarget()->getViewport();
         this->renderCamera->setAspectRatioFromDimensions(vp.z, vp.w);
+        if (this->sceneSwitchPending) {
+            this->sceneSwitchPending = false;
+            QElapsedTimer switchTimer;
+            switchTimer.start();
+            this->unloadScene();
+            this->loadScene(this->pendingScene);
+            CoreSync::Statistics syncStatistics = this->coreSync->getStatistics();
+            std::cout << "ModelerApp::switchScene() -> Scene rebuilt in " << switchTimer.elapsed() << " ms, "
+                      << this->streamingLoader->getOutstandingCount() << " models streaming in, " << syncStatistics.getQueueDepth()
+                      << " render-thread tasks queued (average wait " << syncStatistics.averageWaitMs << " ms)" << std::endl;
+        }
         this->resolveOnUpdateCallbacks();
+        // the scene's next step simulates while this frame renders; what it simulated last frame is applied now
+        this->simulationThread.sync(Core::Time::getTime() + Core::Time::getDeltaTime(), Core::Time::getDeltaTime());
+        Core::Point3r cameraPosition;
+        this->renderCameraObject->getTransform().applyTransformationTo(cameraPosition);
+        this->streamingLoader->update(this->engine, cameraPosition);
+        this->textureLoader->update(this->engine);
+        // startup is over once everything the initial scene asked for has been streamed in
+        if (StartupTimeline::isRecording() && this->streamingLoader->getOutstandingCount() == 0 && this->textureLoader->getOutstandingCount() == 0) {
+            StartupTimeline::finish();
+            CoreSync::Statistics syncStatistics = this->coreSync->getStatistics();
+            std::cout << "ModelerApp -> Render-thread tasks per frame (" << this->frameBudgetMs << " ms budget, " << syncStatistics.rolledOverFrames
+                      << " frames rolled over): " << CoreSync::formatHistogram(syncStatistics) << std::endl;
+            std::cout << "ModelerApp -> Scene simulation step " << this->simulationThread.getLastStepMs() << " ms, render thread waited "
+                      << this->simulationThread.getLastWaitMs() << " ms for it" << std::endl;
+        }
         this->modelerScene->update();
     }, true);
 
@@ -267,6 +549,8 @@ void ModelerApp::setupRenderCamera() {
 }
 
 void ModelerApp::loadScene(SceneID scene) {
+    StartupTimeline::Scope timelineScope("ModelerApp::loadScene");
+    this->currentScene = scene;
     switch(scene) {
         case SceneID::SunnySky:
         {
@@ -304,6 +588,32 @@ void ModelerApp::loadScene(SceneID scene) {
         }
         break;
     }
+    this->simulationThread.setClient(this->modelerScene->getSimulation());
+}
+
+void ModelerApp::unloadScene() {
+    // the old scene's queued tasks and model loads never run; loads already parsing still warm the caches
+    Core::UInt32 cancelled = this->coreSync->cancel(getSceneTag(this->sceneGeneration));
+    if (cancelled > 0) std::cout << "ModelerApp::unloadScene() -> Cancelled " << cancelled << " queued tasks and loads" << std::endl;
+    this->sceneGeneration++;
+    // waits for a step still simulating the old scene, whose lights are about to be released
+    this->simulationThread.setClient(nullptr);
+    this->coreScene.clearScene(this->persistentSceneObjects);
+    this->modelerScene.reset();
+
+    this->hiddenSceneObjects.clear();
+    for (Core::WeakPointer<Core::Object3D> object : this->persistentSceneObjects) {
+        this->setSceneObjectHidden(object, true);
+    }
+
+    // every scene positions the camera relative to where it starts out
+    this->renderCameraObject->getTransform().getLocalMatrix().setIdentity();
+    this->renderCameraObject->getTransform().updateWorldMatrix();
+}
+
+CoreSync::Tag ModelerApp::getSceneTag(Core::UInt32 generation) {
+    // 0 is CoreSync's untagged
+    return (CoreSync::Tag)generation + 1;
 }
 
 void ModelerApp::setupHighlightMaterials() {
@@ -378,6 +688,7 @@ void ModelerApp::preRenderCallback() {
 void ModelerApp::postRenderCallback() {
     this->renderOutline();
     this->updateFPS();
+    this->frameBudget->reset();
 }
 
 void ModelerApp::renderOutline() {
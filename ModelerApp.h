@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
 
 #include "Core/Engine.h"
@@ -16,17 +17,25 @@
 #include "Core/material/Shader.h"
 #include "Core/scene/RayCaster.h"
 #include "Core/color/Color.h"
+#include "Core/math/Math.h"
 #include "Core/render/ReflectionProbe.h"
 
 #include "Scene/ModelerScene.h"
 #include "CoreScene.h"
 #include "CoreSync.h"
+#include "SimulationThread.h"
 #include "MouseAdapter.h"
 #include "GestureAdapter.h"
 #include "PipedEventAdapter.h"
 #include "OrbitControls.h"
 #include "BasicRimShadowMaterial.h"
 #include "TransformWidget.h"
+#include "Import/ModelDescription.h"
+#include "Import/ModelCache.h"
+#include "Import/StreamingLoader.h"
+#include "Import/LazyTextureLoader.h"
+#include "Import/AnimationCache.h"
+#include "Util/FrameBudget.h"
 
 
 class RenderWindow;
@@ -44,15 +53,49 @@ public:
 
     using ModelerAppLifecycleEventCallback = std::function<void()>;
     using ModelerAppLoadModelCallback = std::function<void(Core::WeakPointer<Core::Object3D>)>;
+    using ModelerAppLoadModelsCallback = std::function<void(const std::vector<Core::WeakPointer<Core::Object3D>>&)>;
     using ModelerAppLoadAnimationCallback = std::function<void(Core::WeakPointer<Core::Animation>)>;
 
+    // One file of a loadModels() batch, with its own import settings.
+    class ModelLoadRequest {
+    public:
+        std::string path;
+        float scale = 1.0f;
+        // radians, like every smoothingThreshold past the GUI (which converts from degrees)
+        float smoothingThreshold = 80.0f * Core::Math::DegreesToRads;
+        bool zUp = false;
+        bool preserveFBXPivots = true;
+        bool usePhysicalMaterial = true;
+        bool castShadows = true;
+        // reorder for vertex cache, overdraw and fetch locality at import
+        bool optimizeMeshes = true;
+        // the caller will draw the model alpha-blended (see ImportSettings::blended)
+        bool blended = false;
+        // optional, called with this file's root once it (with loadModels(), the whole batch) is in the scene
+        ModelerAppLoadModelCallback callback;
+    };
+
     ModelerApp();
     ~ModelerApp();
     void init();
     void setRenderWindow(RenderWindow* renderWindow);
+    // Render-thread time per frame for queued CoreSync work, and separately for finishing streamed
+    // loads; whatever doesn't fit rolls over to the next frame. Call before the render window initializes.
+    void setFrameBudgetMs(Core::Real frameBudgetMs);
     void loadModel(const std::string& path, float scale, float smoothingThreshold, bool zUp, bool preserveFBXPivots, bool usePhysicalMaterial, bool castShadows, ModelerAppLoadModelCallback callback);
+    // streamed nearest-first relative to the render camera, using the model's eventual world position
+    void loadModel(const std::string& path, float scale, float smoothingThreshold, bool zUp, bool preserveFBXPivots, bool usePhysicalMaterial, bool castShadows, ModelerAppLoadModelCallback callback,
+                   const Core::Point3r& streamingPosition);
+    void loadModel(const ModelLoadRequest& request, const Core::Point3r& streamingPosition);
+    // Parses every file concurrently, then adds them all to the scene in the same frame, in request order.
+    // Files that fail to load are left out of the roots handed to the callback.
+    void loadModels(const std::vector<ModelLoadRequest>& requests, ModelerAppLoadModelsCallback callback);
+    // Starts parsing every distinct file + settings combination on the pool without adding anything to the
+    // scene, so later loads of the same files find them parsed or in progress. Returns the number of distinct imports.
+    Core::UInt32 prefetchModels(const std::vector<ModelLoadRequest>& requests);
     void loadAnimation(const std::string& path, bool addLoopPadding, bool preserveFBXPivots, ModelerAppLoadAnimationCallback callback);
     CoreScene& getCoreScene();
+    ModelCache& getModelCache();
     void onUpdate(ModelerAppLifecycleEventCallback callback);
     std::shared_ptr<CoreSync> getCoreSync();
     bool isSceneObjectHidden(Core::WeakPointer<Core::Object3D> object);
@@ -63,6 +106,12 @@ public:
     Core::WeakPointer<Core::Engine> getEngine();
     void setTransformModeTranslation();
     void setTransformModeRotation();
+    // Replaces the current scene at the start of the next update. Only the scene graph and lights are rebuilt:
+    // parsed models, GPU meshes, textures and skies stay resident in their caches.
+    void switchScene(SceneID scene);
+    // Renders a few more frames in on-demand mode; for changes the render window can't see coming (GUI edits...).
+    void requestRedraw();
+    SceneID getCurrentScene() const;
 
 private:
     void engineReady(Core::WeakPointer<Core::Engine> engine);
@@ -70,7 +119,18 @@ private:
     void gesture(GestureAdapter::GestureEvent event);
     void mouseButton(MouseAdapter::MouseEventType type, Core::UInt32 button, Core::Int32 x, Core::Int32 y);
     void setupRenderCamera();
+    void requestModelLoad(const ModelLoadRequest& request, bool positioned, const Core::Point3r& streamingPosition);
+    static ModelLoadRequest buildLoadRequest(const std::string& path, float scale, float smoothingThreshold, bool zUp, bool preserveFBXPivots, bool usePhysicalMaterial,
+                                             bool castShadows, ModelerAppLoadModelCallback callback);
+    static ImportSettings buildImportSettings(const ModelLoadRequest& request);
+    Core::WeakPointer<Core::Object3D> instantiateModel(Core::WeakPointer<Core::Engine> engine, const ImportSettings& settings, std::shared_ptr<ModelDescription> description);
+    Core::WeakPointer<Core::Object3D> loadModelWithModelLoader(Core::WeakPointer<Core::Engine> engine, const ImportSettings& settings);
+    void addLoadedModelToScene(Core::WeakPointer<Core::Engine> engine, Core::WeakPointer<Core::Object3D> rootObject, const std::string& name,
+                               bool zUp, ModelerAppLoadModelCallback callback);
     void loadScene(SceneID scene);
+    void unloadScene();
+    // CoreSync tag for render-thread work queued on behalf of a scene generation
+    static CoreSync::Tag getSceneTag(Core::UInt32 generation);
     void resolveOnUpdateCallbacks();
     void preRenderCallback();
     void postRenderCallback();
@@ -80,16 +140,34 @@ private:
 
     RenderWindow* renderWindow;
     bool engineIsReady = false;
+    Core::Real frameBudgetMs = FrameBudget::DefaultBudgetMs;
     Core::WeakPointer<Core::Engine> engine;
 
     std::shared_ptr<ModelerScene> modelerScene;
+    SceneID currentScene = SceneID::MoonlitNight;
+    bool sceneSwitchPending = false;
+    // the transform gizmo is on screen; set on the render thread, read by the GUI thread's hover check
+    std::atomic<bool> gizmoVisible{false};
+    SceneID pendingScene = SceneID::MoonlitNight;
+    // bumped on every switch; the scene's tasks and model loads are tagged with it (getSceneTag) and cancelled on the next
+    Core::UInt32 sceneGeneration = 0;
+    // scene root children that outlive scene switches (the render camera)
+    std::vector<Core::WeakPointer<Core::Object3D>> persistentSceneObjects;
     CoreScene coreScene;
     Core::WeakPointer<Core::Camera> renderCamera;
     Core::WeakPointer<Core::Object3D> renderCameraObject;
     std::unordered_map<Core::UInt64, bool> hiddenSceneObjects;
 
     Core::WeakPointer<Core::Scene> scene;
+    // shared by coreSync, streamingLoader and textureLoader, refilled after every frame
+    std::shared_ptr<FrameBudget> frameBudget;
     std::shared_ptr<CoreSync> coreSync;
+    SimulationThread simulationThread;
+    ModelCache modelCache;
+    std::shared_ptr<StreamingLoader> streamingLoader;
+    std::shared_ptr<LazyTextureLoader> textureLoader;
+    std::shared_ptr<AnimationCache> animationCache;
+    std::shared_ptr<MouseAdapter> mouseAdapter;
     std::shared_ptr<GestureAdapter> gestureAdapter;
     std::shared_ptr<PipedEventAdapter<GestureAdapter::GestureEvent>> pipedGestureAdapter;
     std::shared_ptr<OrbitControls> orbitControls;
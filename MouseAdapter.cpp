@@ -4,9 +4,13 @@
 #include "Settings.h"
 
 #include <QApplication>
+#include <QElapsedTimer>
 #include <QScreen>
 
-MouseAdapter::MouseAdapter() {
+const Core::UInt32 MouseAdapter::QueueCapacity = 1024;
+const Core::UInt32 MouseAdapter::QueueHighWater = 768;
+
+MouseAdapter::MouseAdapter(): queuedEvents(QueueCapacity), latestMovePosition(0), latestMovePending(false), overflowPending(false) {
 
 }
 
@@ -36,9 +40,99 @@ void MouseAdapter::onMouseButtonClicked(ButtonEventCallback callback) {
     this->buttonEventCallbacks[(Core::UInt32)MouseEventType::ButtonClick].push_back(callback);
 }
 
-bool MouseAdapter::processEvent(QObject* obj, QEvent* event) {    
+bool MouseAdapter::processEvent(QObject* obj, QEvent* event) {
+    RawEvent rawEvent;
+    if (!toRawEvent(event, rawEvent)) return false;
+    this->handleEvent(rawEvent);
+    // wheel events were never reported as consumed
+    return rawEvent.type != QEvent::Wheel;
+}
+
+bool MouseAdapter::queueEvent(QEvent* event) {
+    RawEvent rawEvent;
+    if (!toRawEvent(event, rawEvent)) return false;
+    if (rawEvent.type == QEvent::MouseMove) {
+        Core::UInt64 packed = ((Core::UInt64)(Core::UInt32)rawEvent.position.x << 32) | (Core::UInt32)rawEvent.position.y;
+        this->latestMovePosition.store(packed, std::memory_order_relaxed);
+        this->latestMovePending.store(true, std::memory_order_release);
+        return true;
+    }
+
+    // a move the consumer hasn't picked up yet happened before this event, so it goes first
+    RawEvent move;
+    if (this->takeLatestMove(move)) this->pushEvent(move);
+    this->pushEvent(rawEvent);
+    if ((this->queuedEvents.size() >= QueueHighWater || this->overflowPending) && this->backlogCallback) this->backlogCallback();
+    return true;
+}
+
+Core::UInt32 MouseAdapter::drainQueuedEvents() {
+    QElapsedTimer drainTimer;
+    drainTimer.start();
+    Core::UInt32 count = 0;
+    RawEvent rawEvent;
+    while (this->queuedEvents.pop(rawEvent)) {
+        this->handleEvent(rawEvent);
+        count++;
+    }
+    if (this->overflowPending.load(std::memory_order_acquire)) {
+        // with the lock held the producer can't slip anything between the queue and the overflow
+        std::vector<RawEvent> pending;
+        {
+            QMutexLocker ml(&this->overflowMutex);
+            while (this->queuedEvents.pop(rawEvent)) pending.push_back(rawEvent);
+            pending.insert(pending.end(), this->overflow.begin(), this->overflow.end());
+            this->overflow.clear();
+            this->overflowPending = false;
+        }
+        for (const RawEvent& pendingEvent : pending) {
+            this->handleEvent(pendingEvent);
+        }
+        count += (Core::UInt32)pending.size();
+    }
+    // anything still pending came after everything popped above
+    if (this->takeLatestMove(rawEvent)) {
+        this->handleEvent(rawEvent);
+        count++;
+    }
+    this->lastDrainMs = drainTimer.nsecsElapsed() / 1000000.0;
+    return count;
+}
+
+Core::Real MouseAdapter::getLastDrainMs() const {
+    return this->lastDrainMs;
+}
+
+void MouseAdapter::onBacklog(BacklogCallback callback) {
+    this->backlogCallback = callback;
+}
+
+void MouseAdapter::pushEvent(const RawEvent& rawEvent) {
+    // the lock is only taken while something is parked, the queue itself stays lock-free
+    if (this->overflowPending.load(std::memory_order_acquire) || !this->queuedEvents.push(rawEvent)) {
+        QMutexLocker ml(&this->overflowMutex);
+        while (this->overflow.size() > 0 && this->queuedEvents.push(this->overflow.front())) this->overflow.pop_front();
+        if (this->overflow.size() > 0 || !this->queuedEvents.push(rawEvent)) {
+            // a move that doesn't fit is superseded by the next one anyway
+            if (rawEvent.type != QEvent::MouseMove) this->overflow.push_back(rawEvent);
+        }
+        this->overflowPending = this->overflow.size() > 0;
+    }
+}
+
+Core::Bool MouseAdapter::takeLatestMove(RawEvent& rawEvent) {
+    if (!this->latestMovePending.exchange(false, std::memory_order_acquire)) return false;
+    Core::UInt64 packed = this->latestMovePosition.load(std::memory_order_relaxed);
+    rawEvent = RawEvent();
+    rawEvent.type = QEvent::MouseMove;
+    rawEvent.position = Core::Vector2i((Core::Int32)(Core::UInt32)(packed >> 32), (Core::Int32)(Core::UInt32)(packed & 0xFFFFFFFFull));
+    return true;
+}
+
+bool MouseAdapter::toRawEvent(QEvent* event, RawEvent& rawEvent) {
     float dpr = QGuiApplication::primaryScreen()->devicePixelRatio();
     auto eventType = event->type();
+    rawEvent.type = eventType;
     if (eventType == QEvent::MouseButtonPress ||
         eventType == QEvent::MouseButtonRelease ||
         eventType == QEvent::MouseMove) {
@@ -48,13 +142,31 @@ bool MouseAdapter::processEvent(QObject* obj, QEvent* event) {
         QPoint qMousePos = mouseEvent->pos();
         Core::Int32 scaledX = static_cast<int>(static_cast<float>(qMousePos.x()) * dpr);
         Core::Int32 scaledY = static_cast<int>(static_cast<float>(qMousePos.y()) * dpr);
-        Core::Vector2i mousePos(scaledX, scaledY);
+        rawEvent.position = Core::Vector2i(scaledX, scaledY);
+        rawEvent.button = mouseEvent->button();
+        return true;
+    }
+    else if (eventType == QEvent::Wheel) {
+        const QWheelEvent* const wheelEvent = static_cast<const QWheelEvent*>( event );
+        rawEvent.scrollDelta = (Core::Real)wheelEvent->angleDelta().y() / 240.0f;
+        return true;
+    }
+    return false;
+}
+
+void MouseAdapter::handleEvent(const RawEvent& rawEvent) {
+    auto eventType = rawEvent.type;
+    if (eventType == QEvent::MouseButtonPress ||
+        eventType == QEvent::MouseButtonRelease ||
+        eventType == QEvent::MouseMove) {
+
+        Core::Vector2i mousePos = rawEvent.position;
 
         MouseEventType mouseEventType;
         switch(eventType) {
             case QEvent::MouseButtonPress:
             {
-                unsigned int buttonIndex = getMouseButtonIndex(mouseEvent->button());
+                unsigned int buttonIndex = getMouseButtonIndex(rawEvent.button);
                 buttonStatuses[buttonIndex].pressed = true;
                 buttonStatuses[buttonIndex].pressedLocation = mousePos;
                 pressedButtonMask |= 1 << (buttonIndex - 1);
@@ -67,7 +179,7 @@ bool MouseAdapter::processEvent(QObject* obj, QEvent* event) {
             }
             case QEvent::MouseButtonRelease:
             {
-                unsigned int buttonIndex = getMouseButtonIndex(mouseEvent->button());
+                unsigned int buttonIndex = getMouseButtonIndex(rawEvent.button);
                 buttonStatuses[buttonIndex].pressed = false;
                 pressedButtonMask &= ~(1 << (buttonIndex - 1));
                 mouseEventType = MouseEventType::ButtonRelease;
@@ -92,23 +204,16 @@ bool MouseAdapter::processEvent(QObject* obj, QEvent* event) {
             Core::WeakPointer<PipedEventAdapter<MouseEvent>> adapterPtr(this->pipedEventAdapter);
             adapterPtr->accept(event);
         }
-        return true;
     }
     else if (eventType == QEvent::Wheel ) {
-
-         const QWheelEvent* const wheelEvent = static_cast<const QWheelEvent*>( event );
          if (this->pipedEventAdapter) {
              MouseEvent event(MouseEventType::WheelScroll);
-             QPoint pDelta = wheelEvent->angleDelta();
-
-             event.scrollDelta = (Core::Real)wheelEvent->angleDelta().y() / 240.0f;
+             event.scrollDelta = rawEvent.scrollDelta;
              event.buttons = 0;
              Core::WeakPointer<PipedEventAdapter<MouseEvent>> adapterPtr(this->pipedEventAdapter);
              adapterPtr->accept(event);
          }
     }
-
-     return false;
 }
 
 unsigned int MouseAdapter::getMouseButtonIndex(const Qt::MouseButton& button) {
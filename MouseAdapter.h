@@ -1,13 +1,17 @@
 #pragma once
 
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <vector>
 #include <unordered_map>
 
 #include <QMouseEvent>
+#include <QMutex>
 
 #include "PipedEventAdapter.h"
+#include "Util/SPSCQueue.h"
 
 #include "Core/geometry/Vector2.h"
 #include "Core/util/WeakPointer.h"
@@ -37,10 +41,29 @@ public:
 
     using ButtonEventCallback = std::function<void(MouseEventType, Core::UInt32, Core::UInt32, Core::UInt32)>;
     using MoveEventCallback = std::function<void(Core::UInt32, Core::UInt32)>;
+    using BacklogCallback = std::function<void()>;
+
+    static const Core::UInt32 QueueCapacity;
+    // queued presses, releases & scrolls past which the backlog callback asks for a drain
+    static const Core::UInt32 QueueHighWater;
 
     MouseAdapter();
 
+    // Handles the event right away, callbacks included.
     bool processEvent(QObject* obj, QEvent* event);
+    // Producer side, called from the widget's event handlers. Records the event for the next
+    // drainQueuedEvents() instead of handling it during event dispatch; returns false for events
+    // the adapter doesn't handle. Consecutive moves collapse into the latest one, so hovering
+    // without frames being drawn queues nothing; presses, releases and scrolls are never dropped.
+    bool queueEvent(QEvent* event);
+    // Consumer side, at the start of each engine update. Handles everything queued since the last
+    // drain, in order, and returns how many events that was.
+    // Both sides currently run on the GUI thread (paintGL drives Engine::update()), the queue
+    // only keeps input handling out of Qt's dispatch; it stays correct if rendering moves to a thread of its own.
+    Core::UInt32 drainQueuedEvents();
+    Core::Real getLastDrainMs() const;
+    // Producer side. Called once the queue passes QueueHighWater, e.g. to make sure a frame drains it.
+    void onBacklog(BacklogCallback callback);
     bool setPipedEventAdapter(Core::WeakPointer<PipedEventAdapter<MouseEvent>> adapter);
 
     void onMouseMoved(MoveEventCallback callback);
@@ -49,6 +72,20 @@ public:
     void onMouseButtonClicked(ButtonEventCallback callback);
 
 private:
+    // what handling an event needs from the QEvent, copied so it can outlive dispatch
+    class RawEvent {
+    public:
+        QEvent::Type type = QEvent::None;
+        Qt::MouseButton button = Qt::NoButton;
+        Core::Vector2i position;
+        Core::Real scrollDelta = 0.0f;
+    };
+
+    static bool toRawEvent(QEvent* event, RawEvent& rawEvent);
+    void handleEvent(const RawEvent& rawEvent);
+    void pushEvent(const RawEvent& rawEvent);
+    Core::Bool takeLatestMove(RawEvent& rawEvent);
+
     class MouseButtonStatus {
     public:
         bool pressed;
@@ -63,5 +100,18 @@ private:
     Core::WeakPointer<PipedEventAdapter<MouseEvent>> pipedEventAdapter;
     std::unordered_map<Core::UInt32, std::vector<ButtonEventCallback>> buttonEventCallbacks;
     std::vector<MoveEventCallback> moveEventCallbacks;
+
+    SPSCQueue<RawEvent> queuedEvents;
+    // the most recent move not in queuedEvents yet, position packed as x << 32 | y; whichever
+    // side clears latestMovePending first delivers it
+    std::atomic<Core::UInt64> latestMovePosition;
+    std::atomic<Core::Bool> latestMovePending;
+    // events that didn't fit, newer than everything in queuedEvents; the producer moves them into
+    // the queue as it frees up, the consumer takes whatever is left after each drain
+    QMutex overflowMutex;
+    std::deque<RawEvent> overflow;
+    std::atomic<Core::Bool> overflowPending;
+    BacklogCallback backlogCallback;
+    Core::Real lastDrainMs = 0.0f;
 };
 
@@ -12,14 +12,14 @@ void OpenGLMouseAdapterWidget::setMouseAdapter(std::shared_ptr<MouseAdapter> ada
 void OpenGLMouseAdapterWidget::mousePressEvent(QMouseEvent *event)
 {
     if(this->mouseAdapter) {;
-        this->mouseAdapter->processEvent(this, event);
+        this->mouseAdapter->queueEvent(event);
     }
 }
 
 void OpenGLMouseAdapterWidget::mouseReleaseEvent(QMouseEvent *event)
 {
     if(this->mouseAdapter) {;
-        this->mouseAdapter->processEvent(this, event);
+        this->mouseAdapter->queueEvent(event);
     }
 }
 
@@ -27,14 +27,14 @@ void OpenGLMouseAdapterWidget::mouseReleaseEvent(QMouseEvent *event)
 void OpenGLMouseAdapterWidget::mouseMoveEvent(QMouseEvent *event)
 {
     if(this->mouseAdapter) {
-        this->mouseAdapter->processEvent(this, event);
+        this->mouseAdapter->queueEvent(event);
     }
 }
 
 void OpenGLMouseAdapterWidget::wheelEvent(QWheelEvent *event)
 {
     if(this->mouseAdapter) {;
-        this->mouseAdapter->processEvent(this, event);
+        this->mouseAdapter->queueEvent(event);
     }
 }
 
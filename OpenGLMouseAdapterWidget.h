@@ -6,6 +6,7 @@
 
 #include "MouseAdapter.h"
 
+// Hands mouse input to the adapter's queue; it's handled when the render thread drains it.
 class OpenGLMouseAdapterWidget : public QOpenGLWidget
 {
 public:
@@ -1,4 +1,5 @@
 #include "RenderWindow.h"
+#include "Util/StartupTimeline.h"
 
 #include <math.h>
 #include <QTimer>
@@ -9,9 +10,12 @@
 #include <QScreen>
 
 bool RenderWindow::m_transparent = false;
+const Core::UInt32 RenderWindow::SettleFrameCount = 3;
+const Core::UInt32 RenderWindow::DefaultUnfocusedIntervalMs = 250;
 
 RenderWindow::RenderWindow(QWidget *parent): OpenGLMouseAdapterWidget(parent),
-                           initialized(false), engineInitialized(false), engine(nullptr)
+                           initialized(false), engineInitialized(false), engine(nullptr), frameTimer(nullptr),
+                           renderMode(RenderMode::OnDemand), unfocusedIntervalMs(DefaultUnfocusedIntervalMs), requestedFrames(0)
 {
     m_core = QSurfaceFormat::defaultFormat().profile() == QSurfaceFormat::CoreProfile;
     // --transparent causes the clear color to be transparent. Therefore, on systems that
@@ -49,17 +53,92 @@ void RenderWindow::cleanup()
 }
 
 void RenderWindow::start() {
-    QTimer *timer = new QTimer(this);
-    connect(timer, SIGNAL(timeout()), this, SLOT(mainLoop()));
-    timer->start(1);
+    this->frameTimer = new QTimer(this);
+    this->frameTimer->setSingleShot(true);
+    connect(this->frameTimer, SIGNAL(timeout()), this, SLOT(mainLoop()));
+    connect(qApp, SIGNAL(applicationStateChanged(Qt::ApplicationState)), this, SLOT(applicationStateChanged()));
+    this->requestFrames(SettleFrameCount);
+    this->scheduleFrame();
 }
 
 void RenderWindow::mainLoop() {
     this->update();
 }
 
+void RenderWindow::scheduleFrame() {
+    if (!this->frameTimer || this->frameTimer->isActive()) return;
+
+    Core::UInt32 intervalMs = 1;
+    if (QGuiApplication::applicationState() != Qt::ApplicationActive) {
+        if (this->unfocusedIntervalMs == 0) return;
+        intervalMs = this->unfocusedIntervalMs;
+    }
+    if (this->renderMode == RenderMode::OnDemand) {
+        Core::Bool active = this->requestedFrames > 0 || (this->activityCheck && this->activityCheck());
+        if (!active) return;
+    }
+    this->frameTimer->start(intervalMs);
+}
+
+void RenderWindow::applicationStateChanged() {
+    // whatever was deferred while inactive (or the interval it was deferred with) is rescheduled
+    if (this->frameTimer) this->frameTimer->stop();
+    this->requestFrames();
+}
+
+void RenderWindow::setRenderMode(RenderMode mode) {
+    this->renderMode = mode;
+    this->requestFrames();
+}
+
+RenderWindow::RenderMode RenderWindow::getRenderMode() const {
+    return this->renderMode;
+}
+
+void RenderWindow::setActivityCheck(ActivityCheck check) {
+    this->activityCheck = check;
+}
+
+void RenderWindow::setHoverCheck(HoverCheck check) {
+    this->hoverCheck = check;
+}
+
+void RenderWindow::setUnfocusedIntervalMs(Core::UInt32 intervalMs) {
+    this->unfocusedIntervalMs = intervalMs;
+}
+
+void RenderWindow::requestFrames(Core::UInt32 count) {
+    Core::UInt32 requested = this->requestedFrames;
+    while (requested < count && !this->requestedFrames.compare_exchange_weak(requested, count)) {}
+    // the timer belongs to the GUI thread
+    QMetaObject::invokeMethod(this, "scheduleFrame", Qt::QueuedConnection);
+}
+
+void RenderWindow::mousePressEvent(QMouseEvent *event) {
+    OpenGLMouseAdapterWidget::mousePressEvent(event);
+    this->requestFrames(SettleFrameCount);
+}
+
+void RenderWindow::mouseReleaseEvent(QMouseEvent *event) {
+    OpenGLMouseAdapterWidget::mouseReleaseEvent(event);
+    this->requestFrames(SettleFrameCount);
+}
+
+void RenderWindow::mouseMoveEvent(QMouseEvent *event) {
+    OpenGLMouseAdapterWidget::mouseMoveEvent(event);
+    // dragging (camera, gizmo) always changes the frame, hovering only when the hover check says so;
+    // either way the move also has to be drained from the mouse queue by a frame to be handled at all
+    if (event->buttons() != Qt::NoButton || (this->hoverCheck && this->hoverCheck())) this->requestFrames(SettleFrameCount);
+}
+
+void RenderWindow::wheelEvent(QWheelEvent *event) {
+    OpenGLMouseAdapterWidget::wheelEvent(event);
+    this->requestFrames(SettleFrameCount);
+}
+
 void RenderWindow::initializeGL()
 {
+    StartupTimeline::Scope timelineScope("RenderWindow::initializeGL");
     // In this example the widget's corresponding top-level window can change
     // several times during the widget's lifetime. Whenever this happens, the
     // QOpenGLWidget's associated context is destroyed and a new one is created.
@@ -94,6 +173,9 @@ void RenderWindow::paintGL()
     this->engineUpdate();
     this->engineRender();
 
+    Core::UInt32 requested = this->requestedFrames;
+    while (requested > 0 && !this->requestedFrames.compare_exchange_weak(requested, requested - 1)) {}
+    this->scheduleFrame();
 }
 
 void RenderWindow::resizeGL(int w, int h) {
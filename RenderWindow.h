@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
 
 #include <QOpenGLWidget>
@@ -8,6 +9,7 @@
 #include <QOpenGLBuffer>
 #include <QMatrix4x4>
 #include <QMutex>
+#include <QTimer>
 
 #include "OpenGLMouseAdapterWidget.h"
 
@@ -24,6 +26,22 @@ class RenderWindow : public OpenGLMouseAdapterWidget, protected QOpenGLFunctions
 public:
 
     typedef std::function<void(RenderWindow*)> LifeCycleEventCallback;
+    // asked after every frame in on-demand mode; true while something on screen is still changing
+    typedef std::function<bool()> ActivityCheck;
+    // asked on mouse moves with no button held; true while hovering can change what's on screen
+    // (a transform gizmo highlights the axis under the cursor). Called on the GUI thread.
+    typedef std::function<bool()> HoverCheck;
+
+    enum class RenderMode {
+        // a frame every millisecond, whether or not anything changed
+        Continuous = 0,
+        // frames only while the activity check or requestFrames() asks for them, or on input
+        OnDemand = 1
+    };
+
+    // frames rendered after the last change, so effects that converge over a few frames settle
+    static const Core::UInt32 SettleFrameCount;
+    static const Core::UInt32 DefaultUnfocusedIntervalMs;
 
     RenderWindow(QWidget *parent = 0);
     ~RenderWindow();
@@ -39,9 +57,21 @@ public:
     QMutex& getUpdateMutex();
     void start();
 
+    void setRenderMode(RenderMode mode);
+    RenderMode getRenderMode() const;
+    void setActivityCheck(ActivityCheck check);
+    void setHoverCheck(HoverCheck check);
+    // While the application isn't active, frames that are still needed come at most this often;
+    // 0 stops rendering until it is active again.
+    void setUnfocusedIntervalMs(Core::UInt32 intervalMs);
+    // Callable from any thread. In on-demand mode, makes sure at least count more frames get rendered.
+    void requestFrames(Core::UInt32 count = 1);
+
 public slots:
     void cleanup();
     void mainLoop();
+    void scheduleFrame();
+    void applicationStateChanged();
 
 signals:
 
@@ -49,6 +79,10 @@ protected:
     void initializeGL() override;
     void paintGL() override;
     void resizeGL(int width, int height) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
 
 private:
 
@@ -70,4 +104,11 @@ private:
     bool engineInitialized;
     Core::PersistentWeakPointer<Core::Engine> engine;
     std::vector<LifeCycleEventCallback> onInits;
+
+    QTimer* frameTimer;
+    RenderMode renderMode;
+    ActivityCheck activityCheck;
+    HoverCheck hoverCheck;
+    Core::UInt32 unfocusedIntervalMs;
+    std::atomic<Core::UInt32> requestedFrames;
 };
@@ -0,0 +1,20 @@
+#include "MaterialInterner.h"
+
+MaterialInterner::MaterialInterner() {
+
+}
+
+Core::WeakPointer<Core::Material> MaterialInterner::intern(const std::string& key, MaterialFactory create) {
+    this->requestCount++;
+    Core::WeakPointer<Core::Material>& material = this->materials[key];
+    if (!material.isValid()) material = create();
+    return material;
+}
+
+Core::UInt32 MaterialInterner::getUniqueCount() const {
+    return this->materials.size();
+}
+
+Core::UInt32 MaterialInterner::getRequestCount() const {
+    return this->requestCount;
+}
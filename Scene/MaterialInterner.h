@@ -0,0 +1,29 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include "Core/Engine.h"
+#include "Core/material/Material.h"
+
+// Hands out one shared Material per distinct configuration so identically set up meshes
+// render with the same instance (one set of uniform uploads, batchable draws). Callers
+// build the key from everything that makes a material distinct: shader type, source
+// textures and every parameter they set.
+class MaterialInterner {
+public:
+    using MaterialFactory = std::function<Core::WeakPointer<Core::Material>()>;
+
+    MaterialInterner();
+
+    // Returns the material already interned under key, otherwise the one create() builds.
+    Core::WeakPointer<Core::Material> intern(const std::string& key, MaterialFactory create);
+
+    Core::UInt32 getUniqueCount() const;
+    Core::UInt32 getRequestCount() const;
+
+private:
+    std::unordered_map<std::string, Core::WeakPointer<Core::Material>> materials;
+    Core::UInt32 requestCount = 0;
+};
@@ -10,3 +10,11 @@ ModelerScene::~ModelerScene() {
 void ModelerScene::load() {
     this->loadComplete = true;
 }
+
+bool ModelerScene::isAnimating() {
+    return this->sceneHelper.getPlayingAnimationCount() > 0;
+}
+
+std::shared_ptr<SimulationThread::Client> ModelerScene::getSimulation() {
+    return std::shared_ptr<SimulationThread::Client>();
+}
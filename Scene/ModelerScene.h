@@ -1,6 +1,9 @@
 #pragma once
 
+#include <memory>
+
 #include "SceneHelper.h"
+#include "SimulationThread.h"
 
 #include "Core/Engine.h"
 #include "Core/render/Camera.h"
@@ -15,6 +18,11 @@ public:
 
     virtual void load();
     virtual void update() = 0;
+    // true while the scene changes on its own from frame to frame (animations, particles...)
+    virtual bool isAnimating();
+    // Per-frame state of the scene's own that ModelerApp simulates one frame ahead on its
+    // SimulationThread rather than in update(); none by default.
+    virtual std::shared_ptr<SimulationThread::Client> getSimulation();
 
 protected:
     ModelerApp& modelerApp;
@@ -1,6 +1,10 @@
 #include "MoonlitNightScene.h"
 
-#include "Core/image/TextureUtils.h"
+#include "SceneAssets.h"
+#include "Import/CubeTextureCache.h"
+#include "Util/StartupTimeline.h"
+#include "Exception.h"
+#include "Import/CompressedTextureCache.h"
 #include "Core/image/Texture2D.h"
 #include "Core/material/StandardPhysicalMaterial.h"
 #include "Core/geometry/GeometryUtils.h"
@@ -40,6 +44,7 @@
 
 MoonlitNightScene::MoonlitNightScene(ModelerApp& modelerApp): ModelerScene(modelerApp) {
     this->frameCount = 0;
+    this->flickerLights = std::make_shared<FlickerLightGroup>();
 }
 
 void MoonlitNightScene::load() {
@@ -54,6 +59,13 @@ void MoonlitNightScene::load() {
     cameraObj->getTransform().updateWorldMatrix();
     cameraObj->getTransform().lookAt(Core::Point3r(0, 0, 0));
 
+    // start parsing this scene's own models before the shared ones are queued
+    // manifests are compiled into scenes.qrc, so a failure here is a broken build rather than bad input
+    if (!this->uniqueManifest.load(SceneAssets::MoonlitNightManifest)) {
+        throw Exception("MoonlitNightScene::load() -> Unable to load the scene manifest '" + SceneAssets::MoonlitNightManifest + "'");
+    }
+    this->sceneHelper.prefetchManifest(this->uniqueManifest, std::vector<std::string>());
+
     this->setupSkyboxes();
     this->setupCommonSceneElements();
     this->setupUniqueSceneElements();
@@ -63,12 +75,18 @@ void MoonlitNightScene::load() {
 void MoonlitNightScene::update() {
     Core::WeakPointer<Core::Camera> renderCamera = this->modelerApp.getRenderCamera();
     Core::WeakPointer<Core::Engine> engine = this->modelerApp.getEngine();
-    for (unsigned int i = 0; i < this->flickerLights.size(); i++) {
-        this->flickerLights[i].update();
-    }
     this->frameCount++;
 }
 
+bool MoonlitNightScene::isAnimating() {
+    // torch flames and flickering lights never stop
+    return this->flickerLights->getCount() > 0 || ModelerScene::isAnimating();
+}
+
+std::shared_ptr<SimulationThread::Client> MoonlitNightScene::getSimulation() {
+    return this->flickerLights;
+}
+
 void MoonlitNightScene::setupSkyboxes() {
     Core::WeakPointer<Core::Camera> renderCamera = this->modelerApp.getRenderCamera();
     Core::WeakPointer<Core::Engine> engine = this->modelerApp.getEngine();
@@ -87,7 +105,7 @@ void MoonlitNightScene::setupSkyboxes() {
     skyboxImages.push_back(Core::ImageLoader::loadImageU("assets/skyboxes/moonlit_night/nightsky_east.png", true, true));
     skyboxTexture->buildFromImages(skyboxImages[0], skyboxImages[1], skyboxImages[2], skyboxImages[3], skyboxImages[4], skyboxImages[5]);*/
 
-    skyboxTexture = Core::TextureUtils::loadFromEquirectangularImage("assets/skyboxes/HDR/puresky_night1_4k.hdr", true, Core::Math::PI * -2.05f);
+    skyboxTexture = CubeTextureCache::loadFromEquirectangularImage(engine, SceneAssets::MoonlitNight.path, SceneAssets::MoonlitNight.isHDR, SceneAssets::MoonlitNight.rotation);
     renderCamera->getSkybox().build(skyboxTexture, true, 1.5f);
     renderCamera->setSkyboxEnabled(true);
 }
@@ -112,7 +130,11 @@ void MoonlitNightScene::setupBaseLights() {
     this->directionalLightObject = engine->createObject3D();
     this->directionalLightObject->setName("Directonal light");
     coreScene.addObjectToScene(directionalLightObject);
-    Core::WeakPointer<Core::DirectionalLight> directionalLight = engine->createDirectionalLight<Core::DirectionalLight>(directionalLightObject, 3, true, 4096, 0.0001, 0.0005);
+    Core::WeakPointer<Core::DirectionalLight> directionalLight;
+    {
+        StartupTimeline::Scope timelineScope("MoonlitNightScene shadow map allocation");
+        directionalLight = engine->createDirectionalLight<Core::DirectionalLight>(directionalLightObject, 3, true, 4096, 0.0001, 0.0005);
+    }
     directionalLight->setIntensity(2.5f);
     directionalLight->setColor(1.0, 1.0, 1.0, 1.0f);
     directionalLight->setShadowSoftness(Core::ShadowLight::Softness::VerySoft);
@@ -127,9 +149,8 @@ void MoonlitNightScene::setupBaseLights() {
 void MoonlitNightScene::setupUniqueSceneElements() {
     Core::WeakPointer<Core::Engine> engine = this->modelerApp.getEngine();
     CoreScene& coreScene = this->modelerApp.getCoreScene();
-    std::function<void(Core::WeakPointer<Core::Object3D>)> dummyOnLoad = [](Core::WeakPointer<Core::Object3D> root){};
 
-    // texture atlases for flame particles systems
+    // texture atlases for flame particles systems, block-compressed with precomputed mips
     std::shared_ptr<Core::FileSystem> fileSystem = Core::FileSystem::getInstance();
     Core::TextureAttributes texAttributes;
     texAttributes.FilterMode = Core::TextureFilter::TriLinear;
@@ -139,37 +160,28 @@ void MoonlitNightScene::setupUniqueSceneElements() {
 
     // Ember atlas
     std::string emberTexturePath = fileSystem->fixupPathForLocalFilesystem("assets/textures/particle_glow_05.png");
-    std::shared_ptr<Core::StandardImage> emberTextureImage = Core::ImageLoader::loadImageU(emberTexturePath, false, true);
-    Core::WeakPointer<Core::Texture2D> emberTexture = Core::Engine::instance()->getGraphicsSystem()->createTexture2D(texAttributes);
-    emberTexture->buildFromImage(emberTextureImage);
+    Core::WeakPointer<Core::Texture2D> emberTexture = CompressedTextureCache::loadTexture(engine, emberTexturePath, texAttributes);
     Core::Atlas emberAtlas(emberTexture);
     emberAtlas.addFrameSet(1, 0.0f, 0.0f, 1.0f, 1.0f);
 
     // Base flame atlas
     std::string baseFlameTexturePath = fileSystem->fixupPathForLocalFilesystem("assets/textures/fire_particle_2_half.png");
-    std::shared_ptr<Core::StandardImage> baseFlameTextureImage;
-    baseFlameTextureImage = Core::ImageLoader::loadImageU(baseFlameTexturePath, false, true);
-    Core::WeakPointer<Core::Texture2D> baseFlameTexture = Core::Engine::instance()->getGraphicsSystem()->createTexture2D(texAttributes);
-    baseFlameTexture->buildFromImage(baseFlameTextureImage);
+    Core::WeakPointer<Core::Texture2D> baseFlameTexture = CompressedTextureCache::loadTexture(engine, baseFlameTexturePath, texAttributes);
     Core::Atlas baseFlameAtlas(baseFlameTexture);
     baseFlameAtlas.addFrameSet(18, 0.0f, 0.0f, 128.0f / 1024.0f, 128.0f / 512.0f);
 
     // Bright flame atlas
     std::string brightFlameTexturePath = fileSystem->fixupPathForLocalFilesystem("assets/textures/fire_particle_4_flat_half.png");
-    std::shared_ptr<Core::StandardImage> brightFlameTextureImage;
-    brightFlameTextureImage = Core::ImageLoader::loadImageU(brightFlameTexturePath, false, true);
-    Core::WeakPointer<Core::Texture2D> fire4Texture = Core::Engine::instance()->getGraphicsSystem()->createTexture2D(texAttributes);
-    fire4Texture->buildFromImage(brightFlameTextureImage);
+    Core::WeakPointer<Core::Texture2D> fire4Texture = CompressedTextureCache::loadTexture(engine, brightFlameTexturePath, texAttributes);
     Core::Atlas brightFlameAtlas(fire4Texture);
     brightFlameAtlas.addFrameSet(16, 0.0f, 0.0f, 212.0f / 1024.0f, 256.0f / 1024.0f);
 
     Core::Real torchIntensity = 180.0f;
     const std::string torchPost("assets/models/cartoonTorch/cartoonTorch.fbx");
-    const std::string campfire("assets/models/toonlevel/campfire/campfire01.fbx");
 
     // torch 1
     FlickerLight torch1FlickerLight = this->createTorchWithFlame(engine, coreScene, emberAtlas, baseFlameAtlas, brightFlameAtlas, 40.4505, 32.0f, -141.762f, 1.0f, 14.0f, torchIntensity, 6);
-    this->flickerLights.push_back(torch1FlickerLight);
+    this->flickerLights->add(torch1FlickerLight);
     Core::WeakPointer<Core::PointLight> torch1Light = torch1FlickerLight.getLight();
     Core::IntMask torch1LightCullingMask = torch1Light->getCullingMask();
     Core::IntMaskUtil::clearBit(&torch1LightCullingMask, 1);
@@ -179,7 +191,7 @@ void MoonlitNightScene::setupUniqueSceneElements() {
 
     // torch 2
     FlickerLight torch2FlickerLight = this->createTorchWithFlame(engine, coreScene, emberAtlas, baseFlameAtlas, brightFlameAtlas, 51.0816f, 32.0f, -141.762f, 1.0f, 14.0f, torchIntensity, 6);
-    this->flickerLights.push_back(torch2FlickerLight);
+    this->flickerLights->add(torch2FlickerLight);
     Core::WeakPointer<Core::PointLight> torch2Light = torch2FlickerLight.getLight();
     Core::IntMask torch2LightCullingMask = torch2Light->getCullingMask();
     Core::IntMaskUtil::clearBit(&torch2LightCullingMask, 1);
@@ -189,7 +201,7 @@ void MoonlitNightScene::setupUniqueSceneElements() {
 
     // campfire
     FlickerLight torch3FlickerLight = this->createTorchFlame(engine, coreScene, emberAtlas, baseFlameAtlas, brightFlameAtlas, 45.4915f, 28.405f, -164.412f, 2.0f, 10.0f, 230.0f);
-    this->flickerLights.push_back(torch3FlickerLight);
+    this->flickerLights->add(torch3FlickerLight);
     Core::WeakPointer<Core::PointLight> torch3Light = torch3FlickerLight.getLight();
     Core::IntMask torch3LightCullingMask = torch3Light->getCullingMask();
     Core::IntMaskUtil::clearBit(&torch3LightCullingMask, 1);
@@ -197,11 +209,10 @@ void MoonlitNightScene::setupUniqueSceneElements() {
     Core::IntMaskUtil::clearBit(&torch3LightCullingMask, 6);
     torch3Light->setCullingMask(torch3LightCullingMask);
     torch3Light->getOwner()->getParent()->getTransform().translate(0.0f, 2.0f, 0.0f);
-    this->sceneHelper.loadModelStandard(campfire, true, false, 0.0f, 0.0f, 0.0f, 0, 1, 0, 0, 45.4915f, 27.2334f, -164.412f, 0.5f, 0.5f, 0.5f, false, 0.0f, 0.85f, false, 0, false, false, false, dummyOnLoad, 2);
 
     // torch 4
     FlickerLight torch4FlickerLight = this->createTorchWithFlame(engine, coreScene, emberAtlas, baseFlameAtlas, brightFlameAtlas, 31.6682f, 30.9f, -169.04f, 1.0f, 14.0f, torchIntensity, 7);
-    this->flickerLights.push_back(torch4FlickerLight);
+    this->flickerLights->add(torch4FlickerLight);
     Core::WeakPointer<Core::PointLight> torch4Light = torch4FlickerLight.getLight();
     Core::IntMask torch4LightCullingMask = torch4Light->getCullingMask();
     Core::IntMaskUtil::clearBit(&torch4LightCullingMask, 1);
@@ -209,28 +220,8 @@ void MoonlitNightScene::setupUniqueSceneElements() {
     Core::IntMaskUtil::clearBit(&torch4LightCullingMask, 6);
     torch4Light->setCullingMask(torch4LightCullingMask);
 
-    // castle fort objects
-    const std::string modularCastleTowerPath("assets/models/modular_castle_tower/modular_castle_tower.fbx");
-    const std::string modularCastleWallGatePath("assets/models/modular_castle_wall_gate/modular_castle_wall_gate.fbx");
-    const std::string modularCastleWallBottomPath("assets/models/modular_castle_wall_bottom/modular_castle_wall_bottom.fbx");
-    const std::string modularCastleWallTopPath("assets/models/modular_castle_wall_top/modular_castle_wall_top.fbx");
-    this->sceneHelper.loadModelStandard(modularCastleTowerPath, true, false, 0.0f, Core::Math::PI / 2.0f, 0.0f, 0, 1, 0, 0, 38.7209, 27.1098f, -146.606f, 0.015f, 0.015f, 0.015f, false, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 4);
-    this->sceneHelper.loadModelStandard(modularCastleTowerPath, true, false, 0.0f, Core::Math::PI / 2.0f, 0.0f, 0, 1, 0, 0, 52.6357, 27.1098f, -146.606f, 0.015f, 0.015f, 0.015f, false, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 4);
-    this->sceneHelper.loadModelStandard(modularCastleWallGatePath, true, false, 0.0f, 0.0f, 0.0f, 0, 1, 0, 0, 45.7019, 27.1098f, -146.371f, 0.015f, 0.015f, 0.015f, false, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 4);
-
-    this->sceneHelper.loadModelStandard(modularCastleWallBottomPath, true, false, 0.0f, -Core::Math::PI / 2.0f, 0.0f, 0, 1, 0, 0, 38.7705f, 27.1098f, -153.457f, 0.015f, 0.015f, 0.015f, false, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 2);
-    this->sceneHelper.loadModelStandard(modularCastleWallTopPath, true, false, 0.0f, -Core::Math::PI / 2.0f, 0.0f, 0, 1, 0, 0, 38.7705f, 27.1098f, -153.457f, 0.015f, 0.015f, 0.015f, false, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 2);
-    this->sceneHelper.loadModelStandard(modularCastleWallBottomPath, true, false, 0.0f, -Core::Math::PI / 2.0f, 0.0f, 0, 1, 0, 0, 38.7705f, 27.1098f, -162.38f, 0.015f, 0.015f, 0.015f, false, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 2);
-    this->sceneHelper.loadModelStandard(modularCastleWallTopPath, true, false, 0.0f, -Core::Math::PI / 2.0f, 0.0f, 0, 1, 0, 0, 38.7705f, 27.1098f, -162.38f, 0.015f, 0.015f, 0.015f, false, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 2);
-
-    this->sceneHelper.loadModelStandard(modularCastleWallBottomPath, true, false, 0.0f, Core::Math::PI / 2.0f, 0.0f, 0, 1, 0, 0, 52.8551f, 27.1098f, -153.457f, 0.015f, 0.015f, 0.015f, false, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 2);
-    this->sceneHelper.loadModelStandard(modularCastleWallTopPath, true, false, 0.0f, Core::Math::PI / 2.0f, 0.0f, 0, 1, 0, 0, 52.8551f, 27.1098f, -153.457f, 0.015f, 0.015f, 0.015f, false, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 2);
-    this->sceneHelper.loadModelStandard(modularCastleWallBottomPath, true, false, 0.0f, Core::Math::PI / 2.0f, 0.0f, 0, 1, 0, 0, 52.8551f, 27.1098f, -162.38f, 0.015f, 0.015f, 0.015f, false, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 2);
-    this->sceneHelper.loadModelStandard(modularCastleWallTopPath, true, false, 0.0f, Core::Math::PI / 2.0f, 0.0f, 0, 1, 0, 0, 52.8551f, 27.1098f, -162.38f, 0.015f, 0.015f, 0.015f, false, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 2);
-
-    this->sceneHelper.loadModelStandard(modularCastleTowerPath, true, false, 0.0f, Core::Math::PI / 2.0f, 0.0f, 0, 1, 0, 0, 38.7209, 27.1098f, -170.606f, 0.02f, 0.02f, 0.02f, false, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 2);
-    this->sceneHelper.loadModelStandard(modularCastleTowerPath, true, false, 0.0f, Core::Math::PI / 2.0f, 0.0f, 0, 1, 0, 0, 52.6357, 27.1098f, -170.606f, 0.02f, 0.02f, 0.02f, false, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 2);
-    this->sceneHelper.loadModelStandard(modularCastleWallGatePath, true, false, 0.0f, 0.0f, 0.0f, 0, 1, 0, 0, 45.7019, 27.1098f, -170.371f, 0.02f, 0.02f, 0.02f, false, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 2);
+    // campfire and castle fort objects
+    this->sceneHelper.loadManifest(this->uniqueManifest, std::vector<std::string>());
 }
 
 FlickerLight MoonlitNightScene::createTorchWithFlame(Core::WeakPointer<Core::Engine> engine, CoreScene& coreScene, Core::Atlas& emberAtlas, Core::Atlas& baseFlameAtlas,
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "Scene/ModelerScene.h"
+#include "Scene/SceneManifest.h"
 #include "CoreScene.h"
 #include "ModelerApp.h"
 #include "FlickerLight.h"
@@ -20,6 +22,8 @@ public:
     MoonlitNightScene(ModelerApp& modelerApp);
     void load() override;
     void update() override;
+    bool isAnimating() override;
+    std::shared_ptr<SimulationThread::Client> getSimulation() override;
 
 private:
     void setupSkyboxes();
@@ -38,5 +42,7 @@ private:
     Core::WeakPointer<Core::Object3D> ambientLightObject;
     Core::WeakPointer<Core::Object3D> directionalLightObject;
     Core::WeakPointer<Core::Object3D>  pointLightObject;
-    std::vector<FlickerLight> flickerLights;
+    std::shared_ptr<FlickerLightGroup> flickerLights;
+    // models specific to this scene: campfire and castle fort
+    SceneManifest uniqueManifest;
 };
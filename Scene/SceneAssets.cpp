@@ -0,0 +1,54 @@
+#include "SceneAssets.h"
+
+#include "Core/math/Math.h"
+
+const SceneAssets::Sky SceneAssets::PureSky = {"assets/skyboxes/HDR/puresky1_4k.hdr", true, 0.0f};
+const SceneAssets::Sky SceneAssets::AlpsField = {"assets/skyboxes/HDR/alps_field_4k.hdr", true, Core::Math::PI * -0.85f};
+const SceneAssets::Sky SceneAssets::MoonlitNight = {"assets/skyboxes/HDR/puresky_night1_4k.hdr", true, Core::Math::PI * -2.05f};
+const SceneAssets::Sky SceneAssets::Sunrise = {"assets/skyboxes/8k10pack/sky-6_flipped.png", false, -2.9f};
+const SceneAssets::Sky SceneAssets::Sunset = {"assets/skyboxes/HDR/Sky-4.hdr", true, Core::Math::PI * -0.85f};
+
+const std::string SceneAssets::CommonManifest = ":/scenes/common.json";
+const std::string SceneAssets::MoonlitNightManifest = ":/scenes/moonlit_night.json";
+
+std::vector<SceneAssets::Sky> SceneAssets::getSkies() {
+    return {PureSky, AlpsField, MoonlitNight, Sunrise, Sunset};
+}
+
+std::vector<std::string> SceneAssets::getManifests() {
+    return {CommonManifest, MoonlitNightManifest};
+}
+
+ImportSettings SceneAssets::getStandardImport(const std::string& path, Core::Bool usePhysicalMaterial, Core::Bool castShadows, Core::Bool transparent) {
+    ImportSettings settings;
+    settings.path = path;
+    settings.scale = 1.0f;
+    settings.smoothingThreshold = 85 * Core::Math::DegreesToRads;
+    settings.preserveFBXPivots = true;
+    settings.usePhysicalMaterial = usePhysicalMaterial;
+    settings.castShadows = castShadows;
+    // configureStandardMaterial() blends transparent instances, so their triangle order matters
+    settings.blended = transparent;
+    return settings;
+}
+
+ImportSettings SceneAssets::getTerrainImport(Core::Bool usePhysicalMaterial) {
+    ImportSettings settings;
+    settings.path = "assets/models/terrain/terrain.fbx";
+    settings.scale = .01f;
+    // 90 degrees, which is also where ModelerApp::buildImportSettings() clamps
+    settings.smoothingThreshold = Core::Math::PI / 2.0f;
+    settings.preserveFBXPivots = true;
+    settings.usePhysicalMaterial = usePhysicalMaterial;
+    return settings;
+}
+
+ImportSettings SceneAssets::getWarriorImport(Core::Bool usePhysicalMaterial) {
+    ImportSettings settings;
+    settings.path = "assets/models/toonwarrior/character/warrior.fbx";
+    settings.scale = 4.0f;
+    settings.smoothingThreshold = Core::Math::PI / 2.0f;
+    settings.preserveFBXPivots = false;
+    settings.usePhysicalMaterial = usePhysicalMaterial;
+    return settings;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Core/common/types.h"
+
+#include "Import/ModelDescription.h"
+
+// The skies and import settings the scenes load their assets with, kept in one place so the
+// asset baker (Baker/AssetBaker) fills exactly the cache entries the scenes look up. Both cache
+// keys include every value here, so change a scene's settings here rather than at the call site.
+class SceneAssets {
+public:
+    // arguments to CubeTextureCache::loadFromEquirectangularImage()
+    class Sky {
+    public:
+        std::string path;
+        Core::Bool isHDR;
+        Core::Real rotation;
+    };
+
+    static const Sky PureSky;
+    static const Sky AlpsField;
+    static const Sky MoonlitNight;
+    static const Sky Sunrise;
+    static const Sky Sunset;
+
+    // ":/" paths of the manifests compiled into scenes.qrc
+    static const std::string CommonManifest;
+    static const std::string MoonlitNightManifest;
+
+    static std::vector<Sky> getSkies();
+    static std::vector<std::string> getManifests();
+
+    // What SceneHelper::loadModelStandard() imports with, and so every manifest instance and prefetch.
+    static ImportSettings getStandardImport(const std::string& path, Core::Bool usePhysicalMaterial, Core::Bool castShadows, Core::Bool transparent);
+    static ImportSettings getTerrainImport(Core::Bool usePhysicalMaterial);
+    static ImportSettings getWarriorImport(Core::Bool usePhysicalMaterial);
+};
@@ -1,7 +1,13 @@
+#include <algorithm>
+#include <iostream>
+#include <sstream>
 #include <unordered_map>
 
 #include "SceneHelper.h"
+#include "SceneAssets.h"
 #include "ModelerApp.h"
+#include "Exception.h"
+#include "Util/StartupTimeline.h"
 #include "Core/Engine.h"
 #include "Core/material/Material.h"
 #include "Core/material/StandardPhysicalMaterial.h"
@@ -21,6 +27,27 @@
 #include "Core/render/BaseObject3DRenderer.h"
 #include "Core/filesys/FileSystem.h"
 
+namespace {
+    ModelerApp::ModelLoadRequest getLoadRequest(const ImportSettings& settings, bool zUp) {
+        ModelerApp::ModelLoadRequest request;
+        request.path = settings.path;
+        request.scale = settings.scale;
+        request.smoothingThreshold = settings.smoothingThreshold;
+        request.zUp = zUp;
+        request.preserveFBXPivots = settings.preserveFBXPivots;
+        request.usePhysicalMaterial = settings.usePhysicalMaterial;
+        request.castShadows = settings.castShadows;
+        request.optimizeMeshes = settings.optimizeMeshes;
+        request.blended = settings.blended;
+        return request;
+    }
+
+    // the import settings loadModelStandard() uses, so prefetched files are the same cache entries
+    ModelerApp::ModelLoadRequest getStandardLoadRequest(const std::string& path, bool usePhysicalMaterial, bool castShadows, bool transparent) {
+        return getLoadRequest(SceneAssets::getStandardImport(path, usePhysicalMaterial, castShadows, transparent), true);
+    }
+}
+
 SceneHelper::SceneHelper(ModelerApp& modelerApp): modelerApp(modelerApp) {
 }
 
@@ -56,6 +83,7 @@ void SceneHelper::createDemoSpheres() {
 }
 
 Core::WeakPointer<Core::ReflectionProbe> SceneHelper::createSkyboxReflectionProbe(float x, float y, float z) {
+    StartupTimeline::Scope timelineScope("SceneHelper::createSkyboxReflectionProbe");
     Core::WeakPointer<Core::Camera> renderCamera = this->modelerApp.getRenderCamera();
     Core::WeakPointer<Core::Engine> engine = this->modelerApp.getEngine();
     CoreScene& coreScene = this->modelerApp.getCoreScene();
@@ -77,18 +105,15 @@ void SceneHelper::loadModelStandard(const std::string& path, bool usePhysicalMat
                                     float tx, float ty, float tz, float scaleX, float scaleY, float scaleZ, bool singlePassMultiLight, float metallic, float roughness,
                                     bool transparent, unsigned int enabledAlphaChannel, bool doubleSided, bool customShadowRendering, bool castShadows,
                                     std::function<void(Core::WeakPointer<Core::Object3D>)> onLoad, int layer) {
+    StartupTimeline::Scope timelineScope("SceneHelper::loadModelStandard " + path);
 
-    std::function<void(Core::WeakPointer<Core::Object3D>)> onLoaded = [this, overrideLoadedTransform, ex, ey, ez, rx, ry, rz, ra, tx, ty, tz, scaleX, scaleY, scaleZ,
+    std::function<void(Core::WeakPointer<Core::Object3D>)> onLoaded = [this, path, overrideLoadedTransform, ex, ey, ez, rx, ry, rz, ra, tx, ty, tz, scaleX, scaleY, scaleZ,
                                                                        singlePassMultiLight, metallic, roughness, transparent, enabledAlphaChannel, doubleSided,
                                                                        customShadowRendering, onLoad, layer](Core::WeakPointer<Core::Object3D> rootObject){
+        StartupTimeline::Scope timelineScope("SceneHelper::loadModelStandard onLoaded " + path);
         Core::WeakPointer<Core::Engine> engine = this->modelerApp.getEngine();
         Core::WeakPointer<Core::Scene> scene = engine->getActiveScene();
 
-        static Core::WeakPointer<Core::StandardPhysicalMaterialMultiLight> multiLightSinglePassPhysicalMaterial;
-        if (!multiLightSinglePassPhysicalMaterial.isValid()) {
-            multiLightSinglePassPhysicalMaterial = engine->createMaterial<Core::StandardPhysicalMaterialMultiLight>();
-        }
-
         Core::Matrix4x4 rotationMatrix;
         rotationMatrix.makeRotationFromEuler(ex, ey, ez);
         if (!overrideLoadedTransform) rotationMatrix.multiply(rootObject->getTransform().getLocalMatrix());
@@ -101,7 +126,9 @@ void SceneHelper::loadModelStandard(const std::string& path, bool usePhysicalMat
         rootObject->getTransform().getLocalMatrix().copy(transform);
 
         Core::WeakPointer<Core::MeshContainer> firstMeshContainer;
-        scene->visitScene(rootObject, [&firstMeshContainer, &engine, singlePassMultiLight, metallic, roughness, transparent,
+        Core::UInt32 uniqueMaterialsBefore = this->materialInterner.getUniqueCount();
+        Core::UInt32 meshCount = 0;
+        scene->visitScene(rootObject, [this, &firstMeshContainer, &meshCount, singlePassMultiLight, metallic, roughness, transparent,
                                        enabledAlphaChannel, doubleSided, customShadowRendering, layer](Core::WeakPointer<Core::Object3D> obj){
 
             Core::WeakPointer<Core::BaseRenderableContainer> baseRenderableContainer = obj->getBaseRenderableContainer();
@@ -117,52 +144,83 @@ void SceneHelper::loadModelStandard(const std::string& path, bool usePhysicalMat
                     if (objectRenderer) {
                         Core::WeakPointer<Core::MeshRenderer> meshRenderer = Core::WeakPointer<Core::Object3DRenderer<Core::Mesh>>::dynamicPointerCast<Core::MeshRenderer>(objectRenderer);
                         if (meshRenderer) {
-                            Core::WeakPointer<Core::Material> renderMaterial = meshRenderer->getMaterial();
-                            Core::WeakPointer<Core::StandardPhysicalMaterial> physicalMaterial = Core::WeakPointer<Core::Material>::dynamicPointerCast<Core::StandardPhysicalMaterial>(renderMaterial);
-                            if (physicalMaterial) {
-                                physicalMaterial->setMetallic(metallic);
-                                physicalMaterial->setRoughness(roughness);
-                            }
-                            if (singlePassMultiLight) {
-                                Core::WeakPointer<Core::StandardPhysicalMaterialMultiLight> multiLightSinglePassPhysicalMaterialClone =
-                                        Core::WeakPointer<Core::Material>::dynamicPointerCast<Core::StandardPhysicalMaterialMultiLight>(multiLightSinglePassPhysicalMaterial->clone());
-                                multiLightSinglePassPhysicalMaterialClone->copyAttributesFromStandardPhysicalMaterial(physicalMaterial);
-                                meshRenderer->setMaterial(multiLightSinglePassPhysicalMaterialClone);
-                                renderMaterial = physicalMaterial = multiLightSinglePassPhysicalMaterialClone;
-                            }
-                            if (transparent) {
-                                renderMaterial->setBlendingMode(Core::RenderState::BlendingMode::Custom);
-                                renderMaterial->setSourceBlendingFactor(Core::RenderState::BlendingFactor::SrcAlpha);
-                                renderMaterial->setDestBlendingFactor(Core::RenderState::BlendingFactor::OneMinusSrcAlpha);
-                                renderMaterial->setRenderQueue(EngineRenderQueue::AlphaClippedGeometry);
-                                if (enabledAlphaChannel == 1) {
-                                    physicalMaterial->setOpacityChannelRedEnabled(true);
-                                    physicalMaterial->setOpacityChannelAlphaEnabled(false);
-                                }
-                                else if (enabledAlphaChannel == 4) {
-                                    physicalMaterial->setOpacityChannelRedEnabled(false);
-                                    physicalMaterial->setOpacityChannelAlphaEnabled(true);
-                                }
-                                physicalMaterial->setDiscardMask(0x80);
-                            }
-                            if (customShadowRendering) {
-                                renderMaterial->setCustomDepthOutput(true);
-                                renderMaterial->setCustomDepthOutputCopyOverrideMatrialState(true);
-                            }
-                            if (doubleSided) {
-                                renderMaterial->setFaceCullingEnabled(false);
-                                renderMaterial->setCustomDepthOutput(true);
-                                renderMaterial->setCustomDepthOutputStateCopyExcludeFaceCulling(true);
-                            }
+                            meshCount++;
+                            Core::WeakPointer<Core::Material> loadedMaterial = meshRenderer->getMaterial();
+                            // meshes from the same imported material share a prototype across every instance of the model;
+                            // anything else (e.g. Core's own loader) can only match on its own material
+                            Core::WeakPointer<Core::Material> sourceMaterial = this->modelerApp.getModelCache().getPrototypeMaterial(meshContainer->getRenderable(0));
+                            if (!sourceMaterial.isValid()) sourceMaterial = loadedMaterial;
+
+                            std::ostringstream key;
+                            key << (singlePassMultiLight ? "StandardPhysicalMaterialMultiLight" : "StandardPhysicalMaterial") << "|" << sourceMaterial->getObjectID() << "|"
+                                << metallic << "|" << roughness << "|" << transparent << "|" << enabledAlphaChannel << "|" << doubleSided << "|" << customShadowRendering;
+                            Core::WeakPointer<Core::Material> material = this->materialInterner.intern(key.str(), [loadedMaterial, singlePassMultiLight, metallic, roughness,
+                                                                                                                   transparent, enabledAlphaChannel, doubleSided, customShadowRendering]() {
+                                return configureStandardMaterial(loadedMaterial, singlePassMultiLight, metallic, roughness, transparent,
+                                                                 enabledAlphaChannel, doubleSided, customShadowRendering);
+                            });
+                            meshRenderer->setMaterial(material);
                         }
                     }
                 }
             }
         });
+        std::cout << "SceneHelper::loadModelStandard() -> '" << path << "': " << meshCount << " meshes, "
+                  << (this->materialInterner.getUniqueCount() - uniqueMaterialsBefore) << " new unique materials ("
+                  << this->materialInterner.getUniqueCount() << " unique for " << this->materialInterner.getRequestCount() << " meshes in the scene)" << std::endl;
         onLoad(rootObject);
     };
 
-    this->modelerApp.loadModel(path, 1.0f, 85 * Core::Math::DegreesToRads, true, true, usePhysicalMaterial, castShadows, onLoaded);
+    ModelerApp::ModelLoadRequest request = getStandardLoadRequest(path, usePhysicalMaterial, castShadows, transparent);
+    request.callback = onLoaded;
+    this->modelerApp.loadModel(request, Core::Point3r(tx, ty, tz));
+}
+
+Core::WeakPointer<Core::Material> SceneHelper::configureStandardMaterial(Core::WeakPointer<Core::Material> loadedMaterial, bool singlePassMultiLight, float metallic,
+                                                                       float roughness, bool transparent, unsigned int enabledAlphaChannel, bool doubleSided,
+                                                                       bool customShadowRendering) {
+    static Core::WeakPointer<Core::StandardPhysicalMaterialMultiLight> multiLightSinglePassPhysicalMaterial;
+    if (!multiLightSinglePassPhysicalMaterial.isValid()) {
+        multiLightSinglePassPhysicalMaterial = Core::Engine::instance()->createMaterial<Core::StandardPhysicalMaterialMultiLight>();
+    }
+
+    Core::WeakPointer<Core::Material> renderMaterial = loadedMaterial;
+    Core::WeakPointer<Core::StandardPhysicalMaterial> physicalMaterial = Core::WeakPointer<Core::Material>::dynamicPointerCast<Core::StandardPhysicalMaterial>(renderMaterial);
+    if (physicalMaterial) {
+        physicalMaterial->setMetallic(metallic);
+        physicalMaterial->setRoughness(roughness);
+    }
+    if (singlePassMultiLight) {
+        Core::WeakPointer<Core::StandardPhysicalMaterialMultiLight> multiLightSinglePassPhysicalMaterialClone =
+                Core::WeakPointer<Core::Material>::dynamicPointerCast<Core::StandardPhysicalMaterialMultiLight>(multiLightSinglePassPhysicalMaterial->clone());
+        multiLightSinglePassPhysicalMaterialClone->copyAttributesFromStandardPhysicalMaterial(physicalMaterial);
+        renderMaterial = physicalMaterial = multiLightSinglePassPhysicalMaterialClone;
+    }
+    if (transparent) {
+        renderMaterial->setBlendingMode(Core::RenderState::BlendingMode::Custom);
+        renderMaterial->setSourceBlendingFactor(Core::RenderState::BlendingFactor::SrcAlpha);
+        renderMaterial->setDestBlendingFactor(Core::RenderState::BlendingFactor::OneMinusSrcAlpha);
+        renderMaterial->setRenderQueue(EngineRenderQueue::AlphaClippedGeometry);
+        if (enabledAlphaChannel == 1) {
+            physicalMaterial->setOpacityChannelRedEnabled(true);
+            physicalMaterial->setOpacityChannelAlphaEnabled(false);
+        }
+        else if (enabledAlphaChannel == 4) {
+            physicalMaterial->setOpacityChannelRedEnabled(false);
+            physicalMaterial->setOpacityChannelAlphaEnabled(true);
+        }
+        physicalMaterial->setDiscardMask(0x80);
+    }
+    if (customShadowRendering) {
+        renderMaterial->setCustomDepthOutput(true);
+        renderMaterial->setCustomDepthOutputCopyOverrideMatrialState(true);
+    }
+    if (doubleSided) {
+        renderMaterial->setFaceCullingEnabled(false);
+        renderMaterial->setCustomDepthOutput(true);
+        renderMaterial->setCustomDepthOutputStateCopyExcludeFaceCulling(true);
+    }
+    return renderMaterial;
 }
 
 void SceneHelper::loadTerrain(bool usePhysicalMaterial, float rotation) {
@@ -202,7 +260,9 @@ void SceneHelper::loadTerrain(bool usePhysicalMaterial, float rotation) {
         });
     };
 
-    this->modelerApp.loadModel("assets/models/terrain/terrain.fbx", .01f, 90 * Core::Math::DegreesToRads, true, true, usePhysicalMaterial, true, onLoaded);
+    ModelerApp::ModelLoadRequest request = getLoadRequest(SceneAssets::getTerrainImport(usePhysicalMaterial), true);
+    this->modelerApp.loadModel(request.path, request.scale, request.smoothingThreshold, request.zUp, request.preserveFBXPivots, request.usePhysicalMaterial,
+                               request.castShadows, onLoaded);
 }
 
 void SceneHelper::loadWarrior(bool usePhysicalMaterial, float rotation, float x, float y, float z) {
@@ -257,15 +317,25 @@ void SceneHelper::loadWarrior(bool usePhysicalMaterial, float rotation, float x,
             }
         });
 
-        Core::WeakPointer<Core::Animation> animation = Core::Engine::instance()->getModelLoader().loadAnimation("assets/models/toonwarrior/animations/idle.fbx", false, true);
-        Core::WeakPointer<Core::AnimationManager> animationManager = Core::Engine::instance()->getAnimationManager();
-        Core::WeakPointer<Core::AnimationPlayer> animationPlayer = animationManager->retrieveOrCreateAnimationPlayer(firstMeshContainer->getSkeleton());
-        animationPlayer->addAnimation(animation);
-        animationPlayer->setSpeed(animation, 1.0f);
-        animationPlayer->play(animation);
+        // the clip is shared by every warrior and arrives on a later frame
+        this->modelerApp.loadAnimation("assets/models/toonwarrior/animations/idle.fbx", false, true, [this, firstMeshContainer](Core::WeakPointer<Core::Animation> animation) {
+            if (!animation.isValid()) return;
+            Core::WeakPointer<Core::AnimationManager> animationManager = Core::Engine::instance()->getAnimationManager();
+            Core::WeakPointer<Core::AnimationPlayer> animationPlayer = animationManager->retrieveOrCreateAnimationPlayer(firstMeshContainer->getSkeleton());
+            animationPlayer->addAnimation(animation);
+            animationPlayer->setSpeed(animation, 1.0f);
+            animationPlayer->play(animation);
+            this->playingAnimationCount++;
+        });
     };
 
-    this->modelerApp.loadModel("assets/models/toonwarrior/character/warrior.fbx", 4.0f, 90 * Core::Math::DegreesToRads, false, false, usePhysicalMaterial, true, onLoaded);
+    ModelerApp::ModelLoadRequest request = getLoadRequest(SceneAssets::getWarriorImport(usePhysicalMaterial), false);
+    request.callback = onLoaded;
+    this->modelerApp.loadModel(request, Core::Point3r(x, y, z));
+}
+
+Core::UInt32 SceneHelper::getPlayingAnimationCount() const {
+    return this->playingAnimationCount;
 }
 
 void SceneHelper::createBasePlatform() {
@@ -294,6 +364,38 @@ void SceneHelper::createBasePlatform() {
     bottomSlabObj->setStatic(true);
 }
 
+void SceneHelper::prefetchManifest(const SceneManifest& manifest, const std::vector<std::string>& excludedTags) {
+    StartupTimeline::Scope timelineScope("SceneHelper::prefetchManifest " + manifest.getPath());
+    std::vector<ModelerApp::ModelLoadRequest> requests;
+    for (const SceneManifest::ModelInstance& instance : manifest.getModels()) {
+        if (isExcluded(instance, excludedTags)) continue;
+        requests.push_back(getStandardLoadRequest(instance.path, instance.usePhysicalMaterial, instance.castShadows, instance.transparent));
+    }
+    for (const std::string& path : manifest.getPrefetchPaths()) {
+        requests.push_back(getStandardLoadRequest(path, true, true, false));
+    }
+    Core::UInt32 uniqueCount = this->modelerApp.prefetchModels(requests);
+    std::cout << "SceneHelper::prefetchManifest() -> '" << manifest.getPath() << "': " << requests.size() << " instances, "
+              << uniqueCount << " unique models" << std::endl;
+}
+
+void SceneHelper::loadManifest(const SceneManifest& manifest, const std::vector<std::string>& excludedTags) {
+    this->prefetchManifest(manifest, excludedTags);
+    std::function<void(Core::WeakPointer<Core::Object3D>)> dummyOnLoad = [](Core::WeakPointer<Core::Object3D> root){};
+    for (const SceneManifest::ModelInstance& instance : manifest.getModels()) {
+        if (isExcluded(instance, excludedTags)) continue;
+        this->loadModelStandard(instance.path, instance.usePhysicalMaterial, instance.overrideLoadedTransform, instance.rotation[0], instance.rotation[1], instance.rotation[2],
+                                instance.axisRotation[0], instance.axisRotation[1], instance.axisRotation[2], instance.axisRotation[3],
+                                instance.position[0], instance.position[1], instance.position[2], instance.scale[0], instance.scale[1], instance.scale[2],
+                                instance.singlePassMultiLight, instance.metallic, instance.roughness, instance.transparent, instance.alphaChannel,
+                                instance.doubleSided, instance.customShadowRendering, instance.castShadows, dummyOnLoad, instance.layer);
+    }
+}
+
+bool SceneHelper::isExcluded(const SceneManifest::ModelInstance& instance, const std::vector<std::string>& excludedTags) {
+    return instance.tag.size() > 0 && std::find(excludedTags.begin(), excludedTags.end(), instance.tag) != excludedTags.end();
+}
+
 void SceneHelper::setupCommonSceneElements(bool excludeCastle, bool physicalTerain) {
     Core::WeakPointer<Core::Engine> engine = this->modelerApp.getEngine();
     CoreScene& coreScene = this->modelerApp.getCoreScene();
@@ -301,53 +403,17 @@ void SceneHelper::setupCommonSceneElements(bool excludeCastle, bool physicalTera
 
     this->centerProbe = this->createSkyboxReflectionProbe(0.0f, 10.0f, 0.0f);
 
-    const std::string bush1Path("assets/models/bush_5/bush_5.fbx");
-    const std::string tree1Path("assets/models/tree_00/tree_00.fbx");
-    const std::string tree3Path("assets/models/tree_03/tree_03.fbx");
-    const std::string stone2Path("assets/models/stone_02/stone_02.fbx");
-    const std::string stone4Path("assets/models/stone_04/stone_04.fbx");
-    const std::string cliff1Path("assets/models/cliff_01/cliff_01.fbx");
-    const std::string wellPath("assets/models/well/well.fbx");
-    const std::string castle1Path("assets/models/castle/castle.fbx");
-
-    std::function<void(Core::WeakPointer<Core::Object3D>)> dummyOnLoad = [](Core::WeakPointer<Core::Object3D> root){};
-
     this->loadWarrior(true, 0.0f, 45.4452f, 27.18f, -140.123f);
     this->loadTerrain(physicalTerain, Core::Math::PI / 2.0f);
-    if (!excludeCastle) this->loadModelStandard(castle1Path, true, false, 0.0f, Core::Math::PI / 2.0f, 0.0f, 0, 1, 0, 0, 48.82f, 27.62f, -164.77f, 0.015f, 0.015f, 0.015f, false, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 0);
-
-    // front left bushes
-    this->loadModelStandard(bush1Path, true, false, 0.0f, Core::Math::PI / 2.0f, 0.0f, 0, 1, 0, 0, 35.0f, 27.5136f, -135.0f, 0.01f, 0.01f, 0.01f, true, 0.0f, 0.85f, true, 1, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(bush1Path, true, false, 0.0f, 0.0f, 0.0f, 0, 1, 0, 0, 28.6463f, 27.5136, -137.331f, 0.015f, 0.015f, 0.015f, true, 0.0f, 0.85f, true, 1, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(bush1Path, true, false, 0.0f, Core::Math::PI / 2.0f, 0.0f, 0, 1, 0, 0, 23.0214f, 27.5136f, -141.079f, 0.01f, 0.01f, 0.01f, true, 0.0f, 0.85f, true, 1, true, true, true, dummyOnLoad, 0);
-
-
-    // front right objects
-    this->loadModelStandard(tree1Path, true, false, 0.0f, 0.174f, 0.0f, 0, 1, 0, 0, 68.91f, 26.5136f, -139.049f, 0.01f, 0.01f, 0.01f, true, 0.0f, 0.85f, true, 4, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(tree1Path, true, false, 0.0f, 0.0f, 0.0f, 0, 1, 0, 0, 74.83f, 27.5136f, -142.29f, 0.0075f, 0.0075f, 0.0075f, true, 0.0f, 0.85f, true, 4, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(tree3Path, true, false, 0.0f, 0.0f, 0.0f, 0, 1, 0, 0, 85.49f, 26.8536f, -126.29f, 0.0055f, 0.0055f, 0.0075f, true, 0.0f, 0.85f, true, 4, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(bush1Path, true, false, 0.0f, 0.0f, 0.0f, 0, 1, 0, 0, 78.36f, 27.5136f, -146.75f, 0.015f, 0.015f, 0.015f, true, 0.0f, 0.85f, true, 1, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(bush1Path, true, false, 0.0f, 0.0f,  0.0f, 0, 1, 0, 0, 63.26f, 27.5136f, -139.87f, 0.01f,  0.01f, 0.01f, true, 0.0f, 0.85f, true, 1, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(stone2Path, true, false, 0.0f, 2.0f, 0.0f, 0, 1, 0, 0, 79.5061, 25.6019f, -127.909f, 0.015f, 0.025f, 0.07f, true, 0.0f, 0.85f, true, 1, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(wellPath, true, false, 0.0f, 2.0f, 0.0f, 0, 1, 0, 0, 73.74, 27.11f, -154.55f, 0.02f, 0.02f, 0.02f, false, 0.0f, 0.85f, false, 1, false, false, true, dummyOnLoad, 0);
-    this->loadModelStandard(tree1Path, true, false, 0.0f, 0.174f, 0.0f, 0, 1, 0, 0, 93.14F, 26.69f, -138.61f, 0.0075f, 0.0075f, 0.0075f, true, 0.0f, 0.85f, true, 4, true, true, true, dummyOnLoad, 0);
-
-
-    // cliffs
-    this->loadModelStandard(stone4Path, true, false, 0.0f, 2.0f, 0.0f, 0, 1, 0, 0,  55.8991f, 27.178f, -140.469f, 0.015f, 0.025f, 0.01f, true, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 0);
-    this->loadModelStandard(cliff1Path, true, false, -0.2f, 0.0f, 0.0f, 0, 1, 0, 0, 54.098, 4.426f, -121.042f, 0.01f, 0.01f, 0.01f, true, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 1);
-    this->loadModelStandard(cliff1Path, true, true, -1.64f, 0.10983f, -.284439f, 0, 1, 0, 0, 29.1575, 13.3392f, -127.239f, 0.008f, 0.012f, 0.0065f, true, 0.0f, 0.85f, false, 0, false, false, true, dummyOnLoad, 1);
-
-    // random trees
-    this->loadModelStandard(tree1Path, true, false, 0.0f, 0.174f, 0.0f, 0, 1, 0, 0, 24.2924f, 27.095f, -150.216f, 0.011f, 0.011f, 0.015f, true, 0.0f, 0.85f, true, 4, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(tree3Path, true, true, -1.585f, -0.0929f, 0.1719f, 0, 1, 0, 0, 23.9192f, 24.926f, -160.299f, 0.0075f, 0.0075f, 0.015f, true, 0.0f, 0.85f, true, 4, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(tree3Path, true, false, 0.0f, 0.174f, 0.0f, 0, 1, 0, 0, 23.817f, 26.264f, -182.373f, 0.005f, 0.005f, 0.01f, true, 0.0f, 0.85f, true, 4, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(tree3Path, true, false, 0.0f, 0.174f, 0.0f, 0, 1, 0, 0, 18.8396f, 17.9282f, -130.676f, 0.005f, 0.005f, 0.01f, true, 0.0f, 0.85f, true, 4, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(tree1Path, true, false, 0.0f, 0.174f, 0.0f, 0, 1, 0, 0, .940061f, 26.69f, -132.04f, 0.0075f, 0.0075f, 0.0075f, true, 0.0f, 0.85f, true, 4, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(tree1Path, true, false, 0.0f, 0.174f, 0.0f, 0, 1, 0, 0, 5.8642f, 49.927f, -211.811f, 0.0125f, 0.0145f, 0.0125f, true, 0.0f, 0.85f, true, 4, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(tree3Path, true, false, 0.0f, 0.0f, 0.0f, 0, 1, 0, 0, 13.78f, 49.927f, -211.5f, 0.0095f, 0.0095f, 0.0165f, true, 0.0f, 0.85f, true, 4, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(tree1Path, true, false, 0.0f, 2.0f, 0.0f, 0, 1, 0, 0, 56.367f, 56.553f, -211.185f, 0.0115f, 0.0115f, 0.0135f, true, 0.0f, 0.85f, true, 4, true, true, true, dummyOnLoad, 0);
-    this->loadModelStandard(tree1Path, true, false, 0.0f, 2.0f, 0.0f, 0, 1, 0, 0, 86.006f, 11.7081f, -119.096f, 0.0115f, 0.0115f, 0.0135f, true, 0.0f, 0.85f, true, 4, true, true, true, dummyOnLoad, 0);
+
+    SceneManifest manifest;
+    // compiled into scenes.qrc, see MoonlitNightScene::load()
+    if (!manifest.load(SceneAssets::CommonManifest)) {
+        throw Exception("SceneHelper::setupCommonSceneElements() -> Unable to load the scene manifest '" + SceneAssets::CommonManifest + "'");
+    }
+    std::vector<std::string> excludedTags;
+    if (excludeCastle) excludedTags.push_back("castle");
+    this->loadManifest(manifest, excludedTags);
 
     renderCameraObject->getTransform().rotate(0.0f, 1.0f, 0.0f, Core::Math::PI * .8, Core::TransformationSpace::World);
     this->modelerApp.setCameraPosition(48.82f, 45.62f, -104.77f);
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "Core/Engine.h"
+#include "Core/material/Material.h"
+
+#include "MaterialInterner.h"
+#include "SceneManifest.h"
 
 class ModelerApp;
 
@@ -18,8 +22,22 @@ public:
     void createBasePlatform();
     void createDemoSpheres();
     void setupCommonSceneElements(bool excludeCastle, bool physicalTerain);
+    // Starts parsing every distinct model the manifest references, instances tagged with one of
+    // excludedTags aside. loadManifest() does this before adding any instance; scenes can call it
+    // earlier to overlap the parsing with the rest of their setup.
+    void prefetchManifest(const SceneManifest& manifest, const std::vector<std::string>& excludedTags);
+    void loadManifest(const SceneManifest& manifest, const std::vector<std::string>& excludedTags);
+    Core::UInt32 getPlayingAnimationCount() const;
 
 private:
+    static bool isExcluded(const SceneManifest::ModelInstance& instance, const std::vector<std::string>& excludedTags);
+    static Core::WeakPointer<Core::Material> configureStandardMaterial(Core::WeakPointer<Core::Material> loadedMaterial, bool singlePassMultiLight, float metallic,
+                                                                       float roughness, bool transparent, unsigned int enabledAlphaChannel, bool doubleSided,
+                                                                       bool customShadowRendering);
+
     ModelerApp& modelerApp;
     Core::WeakPointer<Core::ReflectionProbe> centerProbe;
+    // materials set up by loadModelStandard(), shared between meshes configured the same way
+    MaterialInterner materialInterner;
+    Core::UInt32 playingAnimationCount = 0;
 };
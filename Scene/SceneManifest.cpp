@@ -0,0 +1,87 @@
+#include <iostream>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+#include "SceneManifest.h"
+
+SceneManifest::SceneManifest() {
+
+}
+
+bool SceneManifest::load(const std::string& path) {
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::ReadOnly)) {
+        std::cout << "SceneManifest::load() -> Unable to open '" << path << "'" << std::endl;
+        return false;
+    }
+
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &error);
+    if (document.isNull() || !document.isObject()) {
+        std::cout << "SceneManifest::load() -> Unable to parse '" << path << "': " << error.errorString().toStdString() << std::endl;
+        return false;
+    }
+    QJsonObject root = document.object();
+
+    std::vector<ModelInstance> models;
+    for (const QJsonValue& value : root.value("models").toArray()) {
+        QJsonObject object = value.toObject();
+        ModelInstance instance;
+        instance.path = object.value("path").toString().toStdString();
+        if (instance.path.size() == 0 || !readReals(object, "rotation", instance.rotation, 3) || !readReals(object, "axisRotation", instance.axisRotation, 4) ||
+            !readReals(object, "position", instance.position, 3) || !readReals(object, "scale", instance.scale, 3)) {
+            std::cout << "SceneManifest::load() -> Malformed model entry " << models.size() << " in '" << path << "'" << std::endl;
+            return false;
+        }
+        instance.tag = object.value("tag").toString().toStdString();
+        instance.usePhysicalMaterial = object.value("usePhysicalMaterial").toBool(instance.usePhysicalMaterial);
+        instance.overrideLoadedTransform = object.value("overrideLoadedTransform").toBool(instance.overrideLoadedTransform);
+        instance.singlePassMultiLight = object.value("singlePassMultiLight").toBool(instance.singlePassMultiLight);
+        instance.metallic = object.value("metallic").toDouble(instance.metallic);
+        instance.roughness = object.value("roughness").toDouble(instance.roughness);
+        instance.transparent = object.value("transparent").toBool(instance.transparent);
+        instance.alphaChannel = object.value("alphaChannel").toInt(instance.alphaChannel);
+        instance.doubleSided = object.value("doubleSided").toBool(instance.doubleSided);
+        instance.customShadowRendering = object.value("customShadowRendering").toBool(instance.customShadowRendering);
+        instance.castShadows = object.value("castShadows").toBool(instance.castShadows);
+        instance.layer = object.value("layer").toInt(instance.layer);
+        models.push_back(instance);
+    }
+
+    std::vector<std::string> prefetchPaths;
+    for (const QJsonValue& value : root.value("prefetch").toArray()) {
+        prefetchPaths.push_back(value.toString().toStdString());
+    }
+
+    this->path = path;
+    this->models.swap(models);
+    this->prefetchPaths.swap(prefetchPaths);
+    return true;
+}
+
+const std::string& SceneManifest::getPath() const {
+    return this->path;
+}
+
+const std::vector<SceneManifest::ModelInstance>& SceneManifest::getModels() const {
+    return this->models;
+}
+
+const std::vector<std::string>& SceneManifest::getPrefetchPaths() const {
+    return this->prefetchPaths;
+}
+
+bool SceneManifest::readReals(const QJsonObject& object, const QString& name, Core::Real* values, Core::UInt32 count) {
+    // absent means keep the defaults
+    if (!object.contains(name)) return true;
+    QJsonArray array = object.value(name).toArray();
+    if ((Core::UInt32)array.size() != count) return false;
+    for (Core::UInt32 i = 0; i < count; i++) {
+        if (!array.at(i).isDouble()) return false;
+        values[i] = array.at(i).toDouble();
+    }
+    return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <QJsonObject>
+
+#include "Core/common/types.h"
+
+// A scene's model instances as data rather than code, so the whole asset set is known
+// before anything is built. Manifests are JSON:
+//
+//   {
+//     "prefetch": ["assets/models/.../extra.fbx"],
+//     "models": [
+//       { "path": "assets/models/tree_00/tree_00.fbx", "rotation": [0, 0.174, 0],
+//         "position": [68.91, 26.5136, -139.049], "scale": [0.01, 0.01, 0.01],
+//         "singlePassMultiLight": true, "transparent": true, "alphaChannel": 4,
+//         "doubleSided": true, "customShadowRendering": true }
+//     ]
+//   }
+//
+// Every model field except "path" is optional and defaults to the values in ModelInstance,
+// which match SceneHelper::loadModelStandard()'s usual arguments. "prefetch" lists files the
+// scene's code loads itself, so they can be parsed along with everything else. An instance
+// with a "tag" can be left out by the scene (e.g. "castle").
+class SceneManifest {
+public:
+    class ModelInstance {
+    public:
+        std::string path;
+        std::string tag;
+        bool usePhysicalMaterial = true;
+        bool overrideLoadedTransform = false;
+        // euler angles, then an extra axis-angle rotation
+        Core::Real rotation[3] = {0.0f, 0.0f, 0.0f};
+        Core::Real axisRotation[4] = {0.0f, 1.0f, 0.0f, 0.0f};
+        Core::Real position[3] = {0.0f, 0.0f, 0.0f};
+        Core::Real scale[3] = {1.0f, 1.0f, 1.0f};
+        bool singlePassMultiLight = false;
+        Core::Real metallic = 0.0f;
+        Core::Real roughness = 0.85f;
+        bool transparent = false;
+        Core::UInt32 alphaChannel = 0;
+        bool doubleSided = false;
+        bool customShadowRendering = false;
+        bool castShadows = true;
+        Core::Int32 layer = 0;
+    };
+
+    SceneManifest();
+
+    // Accepts anything QFile opens, including ":/" resource paths. Returns false (and keeps
+    // nothing) if the file is missing or malformed.
+    bool load(const std::string& path);
+
+    const std::string& getPath() const;
+    const std::vector<ModelInstance>& getModels() const;
+    const std::vector<std::string>& getPrefetchPaths() const;
+
+private:
+    static bool readReals(const QJsonObject& object, const QString& name, Core::Real* values, Core::UInt32 count);
+
+    std::string path;
+    std::vector<ModelInstance> models;
+    std::vector<std::string> prefetchPaths;
+};
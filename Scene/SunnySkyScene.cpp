@@ -1,6 +1,8 @@
 #include "SunnySkyScene.h"
 
-#include "Core/image/TextureUtils.h"
+#include "SceneAssets.h"
+#include "Import/CubeTextureCache.h"
+#include "Util/StartupTimeline.h"
 #include "Core/image/Texture2D.h"
 #include "Core/material/StandardPhysicalMaterial.h"
 #include "Core/geometry/GeometryUtils.h"
@@ -67,11 +69,11 @@ void SunnySkyScene::setupSkyboxes() {
     Core::WeakPointer<Core::CubeTexture> skyTexture;
     switch (this->envSubType) {
         case EnvironmentSubType::Standard:
-            skyTexture = Core::TextureUtils::loadFromEquirectangularImage("assets/skyboxes/HDR/puresky1_4k.hdr", true);
+            skyTexture = CubeTextureCache::loadFromEquirectangularImage(engine, SceneAssets::PureSky.path, SceneAssets::PureSky.isHDR, SceneAssets::PureSky.rotation);
             renderCamera->getSkybox().build(skyTexture, true, 2.0f);
         break;
         case EnvironmentSubType::Alps:
-            skyTexture = Core::TextureUtils::loadFromEquirectangularImage("assets/skyboxes/HDR/alps_field_4k.hdr", true, Core::Math::PI * -0.85f);
+            skyTexture = CubeTextureCache::loadFromEquirectangularImage(engine, SceneAssets::AlpsField.path, SceneAssets::AlpsField.isHDR, SceneAssets::AlpsField.rotation);
             renderCamera->getSkybox().build(skyTexture, true, 3.0f);
         break;
     }
@@ -97,7 +99,11 @@ void SunnySkyScene::setupLights() {
     this->directionalLightObject = engine->createObject3D();
     this->directionalLightObject->setName("Directonal light");
     coreScene.addObjectToScene(directionalLightObject);
-    Core::WeakPointer<Core::DirectionalLight> directionalLight = engine->createDirectionalLight<Core::DirectionalLight>(directionalLightObject, 3, true, 4096, 0.0001, 0.0005);
+    Core::WeakPointer<Core::DirectionalLight> directionalLight;
+    {
+        StartupTimeline::Scope timelineScope("SunnySkyScene shadow map allocation");
+        directionalLight = engine->createDirectionalLight<Core::DirectionalLight>(directionalLightObject, 3, true, 4096, 0.0001, 0.0005);
+    }
     switch (this->envSubType) {
         case EnvironmentSubType::Standard:
             directionalLight->setIntensity(5.0f);
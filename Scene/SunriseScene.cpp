@@ -1,6 +1,8 @@
 #include "SunriseScene.h"
 
-#include "Core/image/TextureUtils.h"
+#include "SceneAssets.h"
+#include "Import/CubeTextureCache.h"
+#include "Util/StartupTimeline.h"
 #include "Core/image/Texture2D.h"
 #include "Core/material/StandardPhysicalMaterial.h"
 #include "Core/geometry/GeometryUtils.h"
@@ -53,7 +55,7 @@ void SunriseScene::setupSkyboxes() {
     skyboxTextureAttributes.MipLevels = 2;
     Core::WeakPointer<Core::CubeTexture> skyboxTexture = engine->createCubeTexture(skyboxTextureAttributes);
 
-    Core::WeakPointer<Core::CubeTexture> skyTexture = Core::TextureUtils::loadFromEquirectangularImage("assets/skyboxes/8k10pack/sky-6_flipped.png", false, -2.9f);
+    Core::WeakPointer<Core::CubeTexture> skyTexture = CubeTextureCache::loadFromEquirectangularImage(engine, SceneAssets::Sunrise.path, SceneAssets::Sunrise.isHDR, SceneAssets::Sunrise.rotation);
     renderCamera->getSkybox().build(skyTexture, true, 2.0f);
     renderCamera->setSkyboxEnabled(true);
 }
@@ -76,7 +78,11 @@ void SunriseScene::setupLights() {
     this->directionalLightObject = engine->createObject3D();
     this->directionalLightObject->setName("Directonal light");
     coreScene.addObjectToScene(directionalLightObject);
-    Core::WeakPointer<Core::DirectionalLight> directionalLight = engine->createDirectionalLight<Core::DirectionalLight>(directionalLightObject, 3, true, 4096, 0.0001, 0.0005);
+    Core::WeakPointer<Core::DirectionalLight> directionalLight;
+    {
+        StartupTimeline::Scope timelineScope("SunriseScene shadow map allocation");
+        directionalLight = engine->createDirectionalLight<Core::DirectionalLight>(directionalLightObject, 3, true, 4096, 0.0001, 0.0005);
+    }
     directionalLight->setIntensity(4.0f);
     directionalLight->setColor(1.0f, .878f, .878f, 1.0f);
     directionalLight->setShadowSoftness(Core::ShadowLight::Softness::VerySoft);
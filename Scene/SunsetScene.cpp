@@ -1,6 +1,8 @@
 #include "SunsetScene.h"
 
-#include "Core/image/TextureUtils.h"
+#include "SceneAssets.h"
+#include "Import/CubeTextureCache.h"
+#include "Util/StartupTimeline.h"
 #include "Core/image/Texture2D.h"
 #include "Core/material/StandardPhysicalMaterial.h"
 #include "Core/geometry/GeometryUtils.h"
@@ -47,7 +49,7 @@ void SunsetScene::update() {
 void SunsetScene::setupSkyboxes() {
     Core::WeakPointer<Core::Camera> renderCamera = this->modelerApp.getRenderCamera();
     Core::WeakPointer<Core::Engine> engine = this->modelerApp.getEngine();
-    Core::WeakPointer<Core::CubeTexture> hdrSkyboxTexture = Core::TextureUtils::loadFromEquirectangularImage("assets/skyboxes/HDR/Sky-4.hdr", true, Core::Math::PI * -0.85f);
+    Core::WeakPointer<Core::CubeTexture> hdrSkyboxTexture = CubeTextureCache::loadFromEquirectangularImage(engine, SceneAssets::Sunset.path, SceneAssets::Sunset.isHDR, SceneAssets::Sunset.rotation);
     renderCamera->getSkybox().build(hdrSkyboxTexture, true, 2.0f);
     renderCamera->setSkyboxEnabled(true);
 }
@@ -70,7 +72,11 @@ void SunsetScene::setupLights() {
     this->directionalLightObject = engine->createObject3D();
     this->directionalLightObject->setName("Directonal light");
     coreScene.addObjectToScene(directionalLightObject);
-    Core::WeakPointer<Core::DirectionalLight> directionalLight = engine->createDirectionalLight<Core::DirectionalLight>(directionalLightObject, 3, true, 4096, 0.0001, 0.0015);
+    Core::WeakPointer<Core::DirectionalLight> directionalLight;
+    {
+        StartupTimeline::Scope timelineScope("SunsetScene shadow map allocation");
+        directionalLight = engine->createDirectionalLight<Core::DirectionalLight>(directionalLightObject, 3, true, 4096, 0.0001, 0.0015);
+    }
     directionalLight->setIntensity(3.5f);
     directionalLight->setColor(1.0f, .85f, .1f, 1.0f);
     directionalLight->setShadowSoftness(Core::ShadowLight::Softness::VerySoft);
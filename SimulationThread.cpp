@@ -0,0 +1,102 @@
+#include "SimulationThread.h"
+
+SimulationThread::Worker::Worker(SimulationThread& owner): owner(owner) {
+
+}
+
+void SimulationThread::Worker::run() {
+    QMutexLocker ml(&this->owner.mutex);
+    while (true) {
+        while (!this->owner.stopping && !this->owner.stepPending) {
+            this->owner.stepRequested.wait(&this->owner.mutex);
+        }
+        if (this->owner.stopping) return;
+
+        this->owner.stepPending = false;
+        this->owner.stepRunning = true;
+        std::shared_ptr<Client> client = this->owner.client;
+        Core::Real time = this->owner.stepTime;
+        Core::Real deltaTime = this->owner.stepDeltaTime;
+        Core::UInt32 slot = this->owner.stepSlot;
+
+        ml.unlock();
+        QElapsedTimer stepTimer;
+        stepTimer.start();
+        if (client) client->simulate(time, deltaTime, slot);
+        Core::Real stepMs = stepTimer.nsecsElapsed() / 1000000.0;
+        ml.relock();
+
+        this->owner.lastStepMs = stepMs;
+        this->owner.stepRunning = false;
+        this->owner.stepFinished.wakeAll();
+    }
+}
+
+SimulationThread::SimulationThread(): worker(*this) {
+    this->worker.start();
+}
+
+SimulationThread::~SimulationThread() {
+    {
+        QMutexLocker ml(&this->mutex);
+        this->stopping = true;
+        this->stepRequested.wakeAll();
+    }
+    this->worker.wait();
+}
+
+void SimulationThread::setClient(std::shared_ptr<Client> client) {
+    this->waitForStep();
+    QMutexLocker ml(&this->mutex);
+    this->client = client;
+    // a step simulated for the old client is never applied to the new one
+    this->stepInFlight = false;
+}
+
+void SimulationThread::sync(Core::Real time, Core::Real deltaTime) {
+    std::shared_ptr<Client> client;
+    Core::UInt32 readySlot;
+    {
+        QMutexLocker ml(&this->mutex);
+        if (!this->client) return;
+        client = this->client;
+        readySlot = this->stepSlot;
+    }
+    Core::Bool ready = this->stepInFlight;
+    Core::Real waitMs = ready ? this->waitForStep() : 0.0f;
+
+    {
+        QMutexLocker ml(&this->mutex);
+        this->lastWaitMs = waitMs;
+        this->stepTime = time;
+        this->stepDeltaTime = deltaTime;
+        this->stepSlot = ready ? 1 - readySlot : readySlot;
+        this->stepPending = true;
+        this->stepRequested.wakeAll();
+    }
+    this->stepInFlight = true;
+
+    // the worker is writing the other slot meanwhile
+    if (ready) client->applySimulation(readySlot);
+}
+
+Core::Real SimulationThread::getLastStepMs() {
+    QMutexLocker ml(&this->mutex);
+    return this->lastStepMs;
+}
+
+Core::Real SimulationThread::getLastWaitMs() {
+    QMutexLocker ml(&this->mutex);
+    return this->lastWaitMs;
+}
+
+Core::Real SimulationThread::waitForStep() {
+    QMutexLocker ml(&this->mutex);
+    if (!this->stepPending && !this->stepRunning) return 0.0f;
+    QElapsedTimer waitTimer;
+    waitTimer.start();
+    while (this->stepPending || this->stepRunning) {
+        this->stepFinished.wait(&this->mutex);
+    }
+    return waitTimer.nsecsElapsed() / 1000000.0;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <memory>
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+#include "Core/Engine.h"
+
+// Runs the editor's own per-frame simulation (flickering lights and the like) one frame ahead
+// of rendering on a thread of its own. Every frame the render thread collects the step started
+// the frame before, starts the next one into the other half of the client's double buffer and
+// then applies the collected half, so the next step simulates while this frame renders.
+//
+// Core's particle systems and animation players advance inside Engine::update() and stay there
+// until Core can step them on their own; clients here are the editor's own scene state.
+class SimulationThread {
+public:
+    class Client {
+    public:
+        virtual ~Client() {}
+        // Simulation thread. Advances to time and writes the result to snapshot slot (0 or 1);
+        // must not touch engine objects.
+        virtual void simulate(Core::Real time, Core::Real deltaTime, Core::UInt32 slot) = 0;
+        // Render thread. Pushes snapshot slot into the engine objects it was simulated for.
+        virtual void applySimulation(Core::UInt32 slot) = 0;
+    };
+
+    SimulationThread();
+    ~SimulationThread();
+
+    // Render thread. Waits for the step in progress before switching, so the old client can be released afterwards.
+    void setClient(std::shared_ptr<Client> client);
+    // Render thread, once per frame; time is when the step started now will be shown.
+    void sync(Core::Real time, Core::Real deltaTime);
+
+    Core::Real getLastStepMs();
+    // how long the last sync() blocked on a step that hadn't finished
+    Core::Real getLastWaitMs();
+
+private:
+    class Worker : public QThread {
+    public:
+        Worker(SimulationThread& owner);
+    protected:
+        void run() override;
+    private:
+        SimulationThread& owner;
+    };
+
+    // returns how long it blocked
+    Core::Real waitForStep();
+
+    Worker worker;
+    QMutex mutex;
+    QWaitCondition stepRequested;
+    QWaitCondition stepFinished;
+
+    // guarded by mutex
+    std::shared_ptr<Client> client;
+    Core::Bool stopping = false;
+    Core::Bool stepPending = false;
+    Core::Bool stepRunning = false;
+    Core::Real stepTime = 0.0f;
+    Core::Real stepDeltaTime = 0.0f;
+    Core::UInt32 stepSlot = 0;
+    Core::Real lastStepMs = 0.0f;
+    Core::Real lastWaitMs = 0.0f;
+
+    // render thread only: whether slot holds a finished step that hasn't been applied
+    Core::Bool stepInFlight = false;
+};
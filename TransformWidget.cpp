@@ -185,6 +185,10 @@ void TransformWidget::addTargetObject(Core::WeakPointer<Core::Object3D> object)
     this->updateTransformationForTargetObjects();
 }
 
+Core::UInt32 TransformWidget::getTargetObjectCount() const {
+    return this->targetObjects.size();
+}
+
 void TransformWidget::removeTargetObject(Core::WeakPointer<Core::Object3D> object) {
     unsigned int index = 0;
     for (std::vector<Core::WeakPointer<Core::Object3D>>::iterator itr = this->targetObjects.begin(); itr != this->targetObjects.end(); ++itr) {
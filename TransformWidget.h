@@ -33,6 +33,7 @@ public:
     void addTargetObject(Core::WeakPointer<Core::Object3D> object);
     void removeTargetObject(Core::WeakPointer<Core::Object3D> object);
     bool hasTargetObject(Core::WeakPointer<Core::Object3D> candidateObject);
+    Core::UInt32 getTargetObjectCount() const;
     void activateTranslationMode();
     void activateRotationMode();
 
@@ -0,0 +1,11 @@
+#include "DevILLock.h"
+
+QMutex DevILLock::mutex;
+
+DevILLock::DevILLock() {
+    mutex.lock();
+}
+
+DevILLock::~DevILLock() {
+    mutex.unlock();
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <QMutex>
+
+// DevIL keeps the bound image, origin mode and error state in globals, so every thread in the
+// process decodes with it under this one lock: import workers and the render thread's calls into
+// Core's image loading (Core::ImageLoader, TextureUtils, Core::ModelLoader's textures) alike.
+// Not recursive; take it around the DevIL calls themselves, or for Core's loaders (which reach
+// DevIL internally) around the outermost call. Workers decode with Qt first (MappedImageSource),
+// so the long holds on the render thread only stall the formats DevIL alone can read.
+class DevILLock final {
+public:
+    DevILLock();
+    ~DevILLock();
+
+    DevILLock(const DevILLock&) = delete;
+    DevILLock& operator=(const DevILLock&) = delete;
+
+private:
+    static QMutex mutex;
+};
@@ -0,0 +1,29 @@
+#include <algorithm>
+
+#include "FrameBudget.h"
+
+const Core::Real FrameBudget::DefaultBudgetMs = 4.0f;
+
+FrameBudget::FrameBudget(): budgetMs(DefaultBudgetMs), remainingMs(DefaultBudgetMs) {
+
+}
+
+void FrameBudget::reset() {
+    this->remainingMs = this->budgetMs;
+}
+
+Core::Real FrameBudget::getRemainingMs() const {
+    return std::max(this->remainingMs, 0.0f);
+}
+
+void FrameBudget::consume(Core::Real spentMs) {
+    this->remainingMs -= spentMs;
+}
+
+void FrameBudget::setBudgetMs(Core::Real budgetMs) {
+    this->budgetMs = budgetMs;
+}
+
+Core::Real FrameBudget::getBudgetMs() const {
+    return this->budgetMs;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+
+#include "Core/common/types.h"
+
+// The render thread's time for deferred work in one frame. CoreSync, StreamingLoader and
+// LazyTextureLoader all draw from the same instance, in that order, so together they stay
+// within it instead of each spending a budget of its own. Every consumer still gets to run
+// one item per frame, so none of their queues can stall behind the others.
+class FrameBudget final {
+public:
+    static const Core::Real DefaultBudgetMs;
+
+    FrameBudget();
+
+    // Render thread, once per frame: the next frame starts with the whole budget.
+    void reset();
+    // Render thread. What's left of this frame's budget, never negative.
+    Core::Real getRemainingMs() const;
+    // Render thread. Takes spentMs off what's left.
+    void consume(Core::Real spentMs);
+
+    // Any thread; takes effect from the next reset().
+    void setBudgetMs(Core::Real budgetMs);
+    Core::Real getBudgetMs() const;
+
+private:
+    std::atomic<Core::Real> budgetMs;
+    Core::Real remainingMs;
+};
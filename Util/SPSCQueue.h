@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "Core/common/types.h"
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread. Capacity
+// is rounded up to a power of two; push() fails instead of blocking when the queue is full.
+template <typename T>
+class SPSCQueue {
+public:
+    SPSCQueue(Core::UInt32 capacity): head(0), tail(0) {
+        Core::UInt32 size = 1;
+        while (size < capacity) size <<= 1;
+        this->slots.resize(size);
+        this->mask = size - 1;
+    }
+
+    // producer only
+    bool push(const T& value) {
+        Core::UInt32 tail = this->tail.load(std::memory_order_relaxed);
+        if (tail - this->head.load(std::memory_order_acquire) > this->mask) return false;
+        this->slots[tail & this->mask] = value;
+        this->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // either side; only a snapshot while the other side is running
+    Core::UInt32 size() const {
+        return this->tail.load(std::memory_order_acquire) - this->head.load(std::memory_order_acquire);
+    }
+
+    Core::UInt32 capacity() const {
+        return this->mask + 1;
+    }
+
+    // consumer only
+    bool pop(T& value) {
+        Core::UInt32 head = this->head.load(std::memory_order_relaxed);
+        if (head == this->tail.load(std::memory_order_acquire)) return false;
+        value = this->slots[head & this->mask];
+        this->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::vector<T> slots;
+    Core::UInt32 mask;
+    // free-running counters, only ever compared by difference so wrapping is harmless
+    std::atomic<Core::UInt32> head;
+    std::atomic<Core::UInt32> tail;
+};
@@ -0,0 +1,109 @@
+#include <iostream>
+
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+
+#include "StartupTimeline.h"
+
+QMutex StartupTimeline::mutex;
+QElapsedTimer StartupTimeline::clock;
+std::atomic<bool> StartupTimeline::recording(false);
+std::vector<StartupTimeline::Entry> StartupTimeline::entries;
+std::vector<Qt::HANDLE> StartupTimeline::threads;
+
+// per-thread state: scope nesting for indentation, and a running byte count scopes take deltas of
+static thread_local Core::UInt32 threadDepth = 0;
+static thread_local Core::UInt64 threadBytesRead = 0;
+
+StartupTimeline::Scope::Scope(const std::string& phase): phase(phase), depth(0), startNs(0), startBytes(0) {
+    this->active = StartupTimeline::isRecording();
+    if (!this->active) return;
+    this->depth = threadDepth++;
+    this->startBytes = threadBytesRead;
+    this->startNs = StartupTimeline::clock.nsecsElapsed();
+}
+
+StartupTimeline::Scope::~Scope() {
+    if (!this->active) return;
+    threadDepth--;
+    Entry entry;
+    entry.phase = this->phase;
+    entry.thread = getThreadIndex();
+    entry.depth = this->depth;
+    entry.startNs = this->startNs;
+    entry.durationNs = StartupTimeline::clock.nsecsElapsed() - this->startNs;
+    entry.bytesRead = threadBytesRead - this->startBytes;
+    StartupTimeline::record(entry);
+}
+
+void StartupTimeline::begin() {
+    QMutexLocker ml(&mutex);
+    if (clock.isValid()) return;
+    clock.start();
+    // the thread calling begin() is thread 0
+    threads.push_back(QThread::currentThreadId());
+    recording = true;
+}
+
+void StartupTimeline::finish() {
+    if (!recording.exchange(false)) return;
+
+    std::vector<Entry> finished;
+    Core::Int64 totalNs;
+    {
+        QMutexLocker ml(&mutex);
+        finished.swap(entries);
+        totalNs = clock.nsecsElapsed();
+    }
+
+    QByteArray out("phase,thread,depth,start_ms,duration_ms,bytes_read\n");
+    for (const Entry& entry : finished) {
+        // indent nested phases so the file also reads as a tree
+        QString phase = QString(entry.depth * 2, ' ') + QString::fromStdString(entry.phase);
+        phase.replace('"', "\"\"");
+        out.append(QString("\"%1\",%2,%3,%4,%5,%6\n").arg(phase).arg(entry.thread).arg(entry.depth)
+                   .arg(entry.startNs / 1000000.0, 0, 'f', 3).arg(entry.durationNs / 1000000.0, 0, 'f', 3).arg(entry.bytesRead).toUtf8());
+    }
+
+    QString outputPath = QString::fromStdString(getOutputPath());
+    QDir().mkpath(QFileInfo(outputPath).absolutePath());
+    QSaveFile file(outputPath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(out) != out.size() || !file.commit()) {
+        std::cout << "StartupTimeline::finish() -> Unable to write '" << outputPath.toStdString() << "'" << std::endl;
+        return;
+    }
+    std::cout << "StartupTimeline::finish() -> Startup took " << totalNs / 1000000 << " ms, " << finished.size()
+              << " phases written to '" << outputPath.toStdString() << "'" << std::endl;
+}
+
+Core::Bool StartupTimeline::isRecording() {
+    return recording;
+}
+
+void StartupTimeline::addBytesRead(Core::UInt64 bytes) {
+    threadBytesRead += bytes;
+}
+
+std::string StartupTimeline::getOutputPath() {
+    QString dataPath = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    return QDir(dataPath).filePath("startup_timeline.csv").toStdString();
+}
+
+void StartupTimeline::record(const Entry& entry) {
+    QMutexLocker ml(&mutex);
+    if (!recording) return;
+    entries.push_back(entry);
+}
+
+Core::UInt32 StartupTimeline::getThreadIndex() {
+    QMutexLocker ml(&mutex);
+    Qt::HANDLE current = QThread::currentThreadId();
+    for (Core::UInt32 i = 0; i < threads.size(); i++) {
+        if (threads[i] == current) return i;
+    }
+    threads.push_back(current);
+    return threads.size() - 1;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <QMutex>
+#include <QElapsedTimer>
+
+#include "Core/common/types.h"
+
+// Records where launch time goes. Scopes placed around startup phases log their wall
+// time, the thread they ran on and the bytes read from disk while they were open; once
+// startup has settled finish() writes the whole timeline out as CSV and recording stops,
+// so scopes left in per-load paths cost next to nothing afterwards.
+class StartupTimeline {
+public:
+    class Scope {
+    public:
+        Scope(const std::string& phase);
+        ~Scope();
+
+    private:
+        std::string phase;
+        Core::Bool active;
+        Core::UInt32 depth;
+        Core::Int64 startNs;
+        Core::UInt64 startBytes;
+    };
+
+    // Called once, as early as possible in main(); all times are relative to it.
+    static void begin();
+    // Writes the timeline and stops recording. Only the first call does anything.
+    static void finish();
+    static Core::Bool isRecording();
+
+    // Called wherever file data is pulled in, so scopes on this thread can attribute it.
+    static void addBytesRead(Core::UInt64 bytes);
+
+    static std::string getOutputPath();
+
+private:
+    class Entry {
+    public:
+        std::string phase;
+        Core::UInt32 thread;
+        Core::UInt32 depth;
+        Core::Int64 startNs;
+        Core::Int64 durationNs;
+        Core::UInt64 bytesRead;
+    };
+
+    static void record(const Entry& entry);
+    static Core::UInt32 getThreadIndex();
+
+    static QMutex mutex;
+    static QElapsedTimer clock;
+    static std::atomic<bool> recording;
+    static std::vector<Entry> entries;
+    static std::vector<Qt::HANDLE> threads;
+};
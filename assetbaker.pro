@@ -0,0 +1,93 @@
+# Headless asset baker: fills the Modeler's model, texture and sky caches ahead of time.
+# Shares the Import code with modeler2.pro; keep the Import lists below in sync with it. Scene
+# settings come from Scene/SceneAssets and the manifests in scenes.qrc, so bakes match what scenes load.
+
+# Set these to the appropriate directories
+CORE_BINARY_DIR=$$PWD/../../Core/build
+
+QT += gui
+QT -= widgets
+
+TARGET = assetbaker
+CONFIG += console
+CONFIG -= app_bundle
+
+HEADERS       = \
+    Baker/AssetBaker.h \
+    Baker/NormalBenchmark.h \
+    Scene/SceneAssets.h \
+    Scene/SceneManifest.h \
+    Exception.h \
+    Util/DevILLock.h \
+    Util/FrameBudget.h \
+    Util/StartupTimeline.h \
+    Import/ModelDescription.h \
+    Import/ModelImporter.h \
+    Import/ModelBuilder.h \
+    Import/ModelCache.h \
+    Import/ModelBinaryCache.h \
+    Import/CubeTextureCache.h \
+    Import/CompressedImage.h \
+    Import/TextureCompressor.h \
+    Import/CompressedTextureCache.h \
+    Import/StreamingLoader.h \
+    Import/LazyTextureLoader.h \
+    Import/MappedIOSystem.h \
+    Import/MappedImageSource.h \
+    Import/AssetDependencyGraph.h \
+    Import/NormalGenerator.h \
+    Import/ImportWorkerPool.h \
+    Import/MeshOptimizer.h \
+    Import/GeometryRegistry.h
+SOURCES       = \
+    Baker/main.cpp \
+    Baker/AssetBaker.cpp \
+    Baker/NormalBenchmark.cpp \
+    Scene/SceneAssets.cpp \
+    Scene/SceneManifest.cpp \
+    Exception.cpp \
+    Util/DevILLock.cpp \
+    Util/FrameBudget.cpp \
+    Util/StartupTimeline.cpp \
+    Import/ModelImporter.cpp \
+    Import/ModelBuilder.cpp \
+    Import/ModelCache.cpp \
+    Import/ModelBinaryCache.cpp \
+    Import/CubeTextureCache.cpp \
+    Import/TextureCompressor.cpp \
+    Import/CompressedTextureCache.cpp \
+    Import/StreamingLoader.cpp \
+    Import/LazyTextureLoader.cpp \
+    Import/MappedIOSystem.cpp \
+    Import/MappedImageSource.cpp \
+    Import/AssetDependencyGraph.cpp \
+    Import/NormalGenerator.cpp \
+    Import/ImportWorkerPool.cpp \
+    Import/MeshOptimizer.cpp \
+    Import/GeometryRegistry.cpp
+
+RESOURCES     = \
+    scenes.qrc
+
+DEFINES += GL_GLEXT_PROTOTYPES
+CONFIG += c++11
+
+INCLUDEPATH += $$CORE_BINARY_DIR/include/
+DEPENDPATH += $$CORE_BINARY_DIR/include/
+
+LIBS += -L$$CORE_BINARY_DIR/ -lcore
+PRE_TARGETDEPS += $$CORE_BINARY_DIR/libcore.a
+
+# For windows, the follow line may need to be uncommented
+# PRE_TARGETDEPS += $$CORE_BINARY_DIR/core.lib
+
+# If you have a custom Assimp location, uncomment the lines below
+#ASSIMP_BINARY_DIR=$$PWD/../assimp-build/bin
+#LIBS += -L$$ASSIMP_BINARY_DIR
+
+# If you have a custom DevIL location, uncomment the lines below
+#DEVIL_BINARY_DIR=$$PWD/../devil/devil-src/DevIL/build
+#LIBS += -L$$DEVIL_BINARY_DIR/lib/x64/
+
+LIBS += -lassimp
+LIBS += -lIL
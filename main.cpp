@@ -3,13 +3,19 @@
 #include <QSurfaceFormat>
 #include <QCommandLineParser>
 #include <QCommandLineOption>
+#include <QStandardPaths>
 
 #include "RenderWindow.h"
 #include "MainWindow.h"
 #include "ModelerApp.h"
+#include "Util/FrameBudget.h"
+#include "Util/StartupTimeline.h"
+#include "Import/ImportWorkerPool.h"
+#include "Import/MeshOptimizer.h"
 
 int main(int argc, char *argv[])
 {
+    StartupTimeline::begin();
     QApplication app(argc, argv);
 
     QCoreApplication::setApplicationName("Modeler");
@@ -25,8 +31,26 @@ int main(int argc, char *argv[])
    // parser.addOption(coreProfileOption);
    // QCommandLineOption transparentOption("transparent", "Transparent window");
    // parser.addOption(transparentOption);
+    QCommandLineOption frameBudgetOption("frame-budget", "Milliseconds per frame for queued render-thread work", "ms",
+                                         QString::number(FrameBudget::DefaultBudgetMs));
+    parser.addOption(frameBudgetOption);
+    QCommandLineOption continuousOption("continuous", "Render continuously instead of only while something changes");
+    parser.addOption(continuousOption);
+    QCommandLineOption unfocusedIntervalOption("unfocused-interval", "Milliseconds between frames while the application is inactive, 0 to stop rendering", "ms",
+                                               QString::number(RenderWindow::DefaultUnfocusedIntervalMs));
+    parser.addOption(unfocusedIntervalOption);
+    // models found in the binary cache aren't optimized again, so only fresh imports report it
+    QCommandLineOption measureOverdrawOption(QString(ImportWorkerPool::MeasureOverdrawArgument).mid(2), "Log the overdraw of every model imported "
+                                             "this run before and after optimization (slows imports down noticeably).");
+    parser.addOption(measureOverdrawOption);
     parser.process(app);
 
+    MeshOptimizer::setOverdrawMeasured(parser.isSet(measureOverdrawOption));
+
+    // models are imported in helper processes when the asset baker is installed next to the application
+    QString importWorker = QStandardPaths::findExecutable("assetbaker", QStringList() << QCoreApplication::applicationDirPath());
+    if (!importWorker.isEmpty()) ImportWorkerPool::setWorkerExecutable(importWorker.toStdString());
+
     QSurfaceFormat fmt;
     fmt.setStencilBufferSize(8);
     fmt.setDepthBufferSize(24);
@@ -43,12 +67,15 @@ int main(int argc, char *argv[])
     MainWindow mainWindow;
 
     ModelerApp* modelerApp = new ModelerApp;
+    modelerApp->setFrameBudgetMs(parser.value(frameBudgetOption).toFloat());
     modelerApp->init();
 
     MainGUI * mainGUI = mainWindow.getMainGUI();
     mainGUI->setModelerApp(modelerApp);
     mainGUI->setQtApp(&app);
     RenderWindow * renderWindow = mainGUI->getRenderWindow();
+    renderWindow->setRenderMode(parser.isSet(continuousOption) ? RenderWindow::RenderMode::Continuous : RenderWindow::RenderMode::OnDemand);
+    renderWindow->setUnfocusedIntervalMs(parser.value(unfocusedIntervalOption).toUInt());
     modelerApp->setRenderWindow(renderWindow);
 
     RenderWindow::setTransparent(false);
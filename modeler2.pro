@@ -22,6 +22,7 @@ HEADERS       = \
     Settings.h \
     PipedEventAdapter.h \
     CoreSync.h \
+    SimulationThread.h \
     GestureAdapter.h \
     OrbitControls.h \
     MainWindow.h \
@@ -35,7 +36,33 @@ HEADERS       = \
     SceneUtils.h \
     Scene/ModelerScene.h \
     Scene/SceneHelper.h \
-    Util/FileUtil.h
+    Scene/MaterialInterner.h \
+    Scene/SceneManifest.h \
+    Scene/SceneAssets.h \
+    Util/DevILLock.h \
+    Util/FrameBudget.h \
+    Util/FileUtil.h \
+    Util/SPSCQueue.h \
+    Util/StartupTimeline.h \
+    Import/ModelDescription.h \
+    Import/ModelImporter.h \
+    Import/ModelBuilder.h \
+    Import/ModelCache.h \
+    Import/ModelBinaryCache.h \
+    Import/CubeTextureCache.h \
+    Import/CompressedImage.h \
+    Import/TextureCompressor.h \
+    Import/CompressedTextureCache.h \
+    Import/StreamingLoader.h \
+    Import/AnimationCache.h \
+    Import/LazyTextureLoader.h \
+    Import/MappedIOSystem.h \
+    Import/MappedImageSource.h \
+    Import/AssetDependencyGraph.h \
+    Import/NormalGenerator.h \
+    Import/ImportWorkerPool.h \
+    Import/MeshOptimizer.h \
+    Import/GeometryRegistry.h
 SOURCES       = \
     FlickerLight.cpp \
     Scene/MoonlitNightScene.cpp \
@@ -50,6 +77,7 @@ SOURCES       = \
     MouseAdapter.cpp \
     Settings.cpp \
     CoreSync.cpp \
+    SimulationThread.cpp \
     GestureAdapter.cpp \
     OrbitControls.cpp \
     CoreScene.cpp \
@@ -62,7 +90,33 @@ SOURCES       = \
     SceneUtils.cpp \
     Scene/ModelerScene.cpp \
     Scene/SceneHelper.cpp \
-    Util/FileUtil.cpp
+    Scene/MaterialInterner.cpp \
+    Scene/SceneManifest.cpp \
+    Scene/SceneAssets.cpp \
+    Util/DevILLock.cpp \
+    Util/FrameBudget.cpp \
+    Util/FileUtil.cpp \
+    Util/StartupTimeline.cpp \
+    Import/ModelImporter.cpp \
+    Import/ModelBuilder.cpp \
+    Import/ModelCache.cpp \
+    Import/ModelBinaryCache.cpp \
+    Import/CubeTextureCache.cpp \
+    Import/TextureCompressor.cpp \
+    Import/CompressedTextureCache.cpp \
+    Import/StreamingLoader.cpp \
+    Import/AnimationCache.cpp \
+    Import/LazyTextureLoader.cpp \
+    Import/MappedIOSystem.cpp \
+    Import/MappedImageSource.cpp \
+    Import/AssetDependencyGraph.cpp \
+    Import/NormalGenerator.cpp \
+    Import/ImportWorkerPool.cpp \
+    Import/MeshOptimizer.cpp \
+    Import/GeometryRegistry.cpp
+
+RESOURCES     = \
+    scenes.qrc
 
 DEFINES += GL_GLEXT_PROTOTYPES
 CONFIG += c++11